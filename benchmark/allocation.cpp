@@ -0,0 +1,341 @@
+/** Verification that steady-state publish and (de)serialisation make no heap allocation
+ * @remark Replaces the global operator new, and malloc where the C library allows, with per-thread counting. After a
+ *  warm-up pass each loop is timed as any other benchmark and fails the run if the publishing thread allocated.
+ *  Covers typed, batch, filtered, SubscribeAll, wildcard, typeId, MessageInfo and history publishes, StreamSerializer::receive and
+ *  StreamDeserializer::update of DefaultSerialisation and MessageInfoSerialisation
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#include "benchmark.hpp"
+
+#include <algorithm> //< std::max
+#include <cstdlib> //< std::malloc, posix_memalign
+#include <memory> //< std::unique_ptr
+#include <new> //< std::bad_alloc
+
+/// Count malloc family calls as well as operator new, requires glibc __libc_malloc and no sanitizer interposing malloc
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+#  define SUB0PUB_BENCHMARK_COUNT_MALLOC 1
+#else
+#  define SUB0PUB_BENCHMARK_COUNT_MALLOC 0
+#endif
+
+namespace
+{
+    thread_local uint64_t tAllocationCount = 0U; ///< Trivial type so access never allocates
+
+#if SUB0PUB_BENCHMARK_COUNT_MALLOC
+    extern "C" void* __libc_malloc( size_t size );
+    extern "C" void* __libc_calloc( size_t count, size_t size );
+    extern "C" void* __libc_realloc( void* memory, size_t size );
+    extern "C" void* __libc_memalign( size_t alignment, size_t size );
+
+    void* rawMalloc( const size_t size ) { ++tAllocationCount; return __libc_malloc( size ); }
+    void* rawMemalign( const size_t alignment, const size_t size ) { ++tAllocationCount; return __libc_memalign( alignment, size ); }
+#else
+    void* rawMalloc( const size_t size ) { ++tAllocationCount; return std::malloc( size ); }
+    void* rawMemalign( const size_t alignment, const size_t size )
+    {
+        ++tAllocationCount;
+        void* memory = nullptr;
+        return (posix_memalign( &memory, std::max( alignment, sizeof(void*) ), size ) == 0) ? memory : nullptr;
+    }
+#endif
+
+    void* allocate( const size_t size )
+    {
+        void* const memory = rawMalloc( size != 0U ? size : 1U );
+        if ( memory == nullptr )
+            throw std::bad_alloc();
+        return memory;
+    }
+
+    void* allocate( const size_t size, const std::align_val_t alignment )
+    {
+        void* const memory = rawMemalign( static_cast<size_t>( alignment ), size != 0U ? size : 1U );
+        if ( memory == nullptr )
+            throw std::bad_alloc();
+        return memory;
+    }
+
+} // END: anonymous
+
+#if SUB0PUB_BENCHMARK_COUNT_MALLOC
+extern "C"
+{
+    void* malloc( size_t size ) { ++tAllocationCount; return __libc_malloc( size ); }
+    void* calloc( size_t count, size_t size ) { ++tAllocationCount; return __libc_calloc( count, size ); }
+    void* realloc( void* memory, size_t size ) { ++tAllocationCount; return __libc_realloc( memory, size ); }
+}
+#endif
+
+void* operator new( size_t size ) { return allocate( size ); }
+void* operator new[]( size_t size ) { return allocate( size ); }
+void* operator new( size_t size, const std::nothrow_t& ) noexcept { return rawMalloc( size != 0U ? size : 1U ); }
+void* operator new[]( size_t size, const std::nothrow_t& ) noexcept { return rawMalloc( size != 0U ? size : 1U ); }
+void* operator new( size_t size, std::align_val_t alignment ) { return allocate( size, alignment ); }
+void* operator new[]( size_t size, std::align_val_t alignment ) { return allocate( size, alignment ); }
+void operator delete( void* memory ) noexcept { std::free( memory ); }
+void operator delete[]( void* memory ) noexcept { std::free( memory ); }
+void operator delete( void* memory, size_t ) noexcept { std::free( memory ); }
+void operator delete[]( void* memory, size_t ) noexcept { std::free( memory ); }
+void operator delete( void* memory, std::align_val_t ) noexcept { std::free( memory ); }
+void operator delete[]( void* memory, std::align_val_t ) noexcept { std::free( memory ); }
+void operator delete( void* memory, size_t, std::align_val_t ) noexcept { std::free( memory ); }
+void operator delete[]( void* memory, size_t, std::align_val_t ) noexcept { std::free( memory ); }
+
+namespace sub0
+{
+    namespace benchmark
+    {
+        uint64_t allocationCount()
+        { return tAllocationCount; }
+
+    } // END: benchmark
+} // END: sub0
+
+namespace
+{
+    using namespace sub0::benchmark;
+
+    struct Sample
+    {
+        uint64_t timestamp;
+        float value;
+        uint32_t channel;
+    };
+
+    /** Sample published with MessageInfo
+    */
+    struct Stamped
+    {
+        uint64_t timestamp;
+        float value;
+        uint32_t channel;
+    };
+
+    typedef Payload<16U, 0x900U> DataB;
+
+    /** Sample retained for late subscribers
+    */
+    struct Retained
+    {
+        uint64_t timestamp;
+        float value;
+        uint32_t channel;
+    };
+
+} // END: anonymous
+
+SUB0_MESSAGE_INFO( Stamped );
+SUB0_HISTORY( Retained, 16 );
+
+namespace
+{
+    const uint32_t cMessageCount = 64U * 1024U; ///< Publishes or frames per iteration
+
+    template< typename Data >
+    class Sink : public sub0::Subscribe<Data>
+    {
+    public:
+        void receive( const Data& data ) override
+        { doNotOptimize( data ); }
+    };
+
+    /** Accepts every other message by content
+    */
+    class FilteredSink : public Sink<Sample>
+    {
+    public:
+        bool filter( const Sample& data ) override
+        { return (data.channel & 1U) == 0U; }
+    };
+
+    class SinkAll : public sub0::SubscribeAll<Sample, DataB>
+    {
+    public:
+        void receive( const Sample& data ) override { doNotOptimize( data ); }
+        void receive( const DataB& data ) override { doNotOptimize( data ); }
+    };
+
+    class Inspector : public sub0::SubscribeAny
+    {
+    public:
+        void receive( const uint32_t typeId, const void* const data, const size_t size ) override
+        { doNotOptimize( typeId ); doNotOptimize( data ); doNotOptimize( size ); }
+    };
+
+    class BytesSink : public sub0::SubscribeBytes
+    {
+    public:
+        explicit BytesSink( const uint32_t typeId )
+            : sub0::SubscribeBytes( typeId )
+        {}
+
+        void receive( const void* const data, const size_t size ) override
+        { doNotOptimize( data ); doNotOptimize( size ); }
+    };
+
+    template< typename Protocol >
+    class Recorder : public sub0::StreamSerializer< Protocol, typename Protocol::Writer, sub0::utility::MemorySink >
+                   , public sub0::ForwardSubscribe< Sample, Recorder<Protocol> >
+                   , public sub0::ForwardSubscribe< Stamped, Recorder<Protocol> >
+    {
+    public:
+        Recorder( sub0::utility::MemorySink& stream )
+            : sub0::StreamSerializer< Protocol, typename Protocol::Writer, sub0::utility::MemorySink >( stream )
+        {}
+    };
+
+    template< typename Protocol >
+    class Decoder : public sub0::StreamDeserializer< Protocol, typename Protocol::Reader, sub0::utility::MemorySource >
+                  , public sub0::ForwardPublish< Sample, Decoder<Protocol> >
+                  , public sub0::ForwardPublish< Stamped, Decoder<Protocol> >
+    {
+    public:
+        Decoder( sub0::utility::MemorySource& stream )
+            : sub0::StreamDeserializer< Protocol, typename Protocol::Reader, sub0::utility::MemorySource >( stream )
+        {}
+    };
+
+    /** Time 'body' and fail the run if any call after the warm-up allocated on this thread
+     */
+    template< typename Body >
+    void verify( Runner& runner, const std::string& name, const std::string& params, const uint64_t itemsPerCall, Body&& body )
+    {
+        if ( !runner.selected( name ) )
+            return;
+
+        body(); //< Warm-up, first publish of a type may register it and first frame of a type sizes reader buffers
+        uint64_t allocations = 0U;
+        runner.measure( name, params, itemsPerCall, 0U, [&]
+        {
+            const uint64_t before = allocationCount();
+            body();
+            allocations += allocationCount() - before;
+        } );
+        if ( allocations != 0U )
+            runner.fail( name, params, std::to_string( allocations ) + " heap allocations" );
+    }
+
+    template< typename Data >
+    void publishAll( const sub0::Publish<Data>& source )
+    {
+        Data data = {};
+        for ( uint32_t iMessage = 0U; iMessage < cMessageCount; ++iMessage )
+        {
+            data.channel = iMessage;
+            source.publish( data );
+        }
+    }
+
+    void brokerModes( Runner& runner )
+    {
+        sub0::Publish<Sample> source;
+        {
+            Sink<Sample> sink;
+            verify( runner, "allocation.publish", "mode=typed", cMessageCount, [&] { publishAll( source ); } );
+
+            std::vector<Sample> batch( cMessageCount );
+            verify( runner, "allocation.publish", "mode=batch", cMessageCount, [&] { source.publish( batch.data(), batch.size() ); } );
+        }
+        {
+            std::vector< std::unique_ptr< Sink<Sample> > > sinks;
+            for ( uint32_t iSubscriber = 0U; iSubscriber < sub0::Broker<Sample>::cMaxSubscriptions; ++iSubscriber )
+                sinks.emplace_back( new Sink<Sample>() );
+            verify( runner, "allocation.publish", "mode=fanout", cMessageCount, [&] { publishAll( source ); } );
+        }
+        {
+            FilteredSink sink;
+            verify( runner, "allocation.publish", "mode=filter", cMessageCount, [&] { publishAll( source ); } );
+        }
+        {
+            SinkAll sink;
+            sub0::Publish<DataB> sourceB;
+            verify( runner, "allocation.publish", "mode=SubscribeAll", 2U * cMessageCount, [&]
+            {
+                publishAll( source );
+                const DataB data = {};
+                for ( uint32_t iMessage = 0U; iMessage < cMessageCount; ++iMessage )
+                    sourceB.publish( data );
+            } );
+        }
+        {
+            Sink<Sample> sink;
+            Inspector inspector;
+            verify( runner, "allocation.publish", "mode=SubscribeAny", cMessageCount, [&] { publishAll( source ); } );
+        }
+        {
+            BytesSink sink( source.typeId() );
+            const sub0::Topic* const topic = sub0::TopicRegistry::find( source.typeId() );
+            verify( runner, "allocation.publish", "mode=Topic", cMessageCount, [&]
+            {
+                Sample data = {};
+                for ( uint32_t iMessage = 0U; iMessage < cMessageCount; ++iMessage )
+                {
+                    data.channel = iMessage;
+                    topic->publish( &data, sizeof(data) );
+                }
+            } );
+        }
+        {
+            sub0::Publish<Stamped> stampedSource;
+            Sink<Stamped> sink;
+            verify( runner, "allocation.publish", "mode=MessageInfo", cMessageCount, [&] { publishAll( stampedSource ); } );
+        }
+        {
+            sub0::Publish<Retained> retainedSource;
+            Sink<Retained> sink;
+            verify( runner, "allocation.publish", "mode=history", cMessageCount, [&]
+            {
+                publishAll( retainedSource );
+                sink.replay();
+            } );
+        }
+    }
+
+    /** StreamSerializer::receive into a fixed buffer, then StreamDeserializer::update back out of it
+     */
+    template< typename Protocol, typename Data >
+    void serialisation( Runner& runner, const std::string& params )
+    {
+        std::vector<char> buffer( cMessageCount * (sizeof(Data) + 64U) );
+        sub0::utility::MemorySink memorySink( buffer.data(), buffer.size() );
+        sub0::Publish<Data> source;
+        {
+            Recorder<Protocol> recorder( memorySink );
+            verify( runner, "allocation.serialize", params, cMessageCount, [&]
+            {
+                memorySink.clear();
+                publishAll( source );
+            } );
+        }
+
+        Sink<Data> sink;
+        sub0::utility::MemorySource memorySource( memorySink.data(), memorySink.size() );
+        Decoder<Protocol> decoder( memorySource );
+        verify( runner, "allocation.deserialize", params, cMessageCount, [&]
+        {
+            memorySource.rewind();
+            decoder.open();
+            while ( decoder.update() ) {}
+        } );
+    }
+
+    void allocation( Runner& runner )
+    {
+        if ( !runner.selected( "allocation." ) )
+            return;
+
+        TypeName<Sample> name( 0x900, "Sample" );
+        TypeName<DataB> nameB( 0x901, "DataB" );
+        TypeName<Stamped> nameStamped( 0x902, "Stamped" );
+
+        brokerModes( runner );
+        serialisation< sub0::DefaultSerialisation, Sample >( runner, "protocol=Default" );
+        serialisation< sub0::MessageInfoSerialisation, Stamped >( runner, "protocol=MessageInfo" );
+    }
+
+} // END: anonymous
+
+SUB0_BENCHMARK( allocation );
@@ -0,0 +1,335 @@
+/** Sub0Pub benchmark harness
+ * @remark Minimal self-contained timing harness, results are emitted as JSON so runs can be compared over time
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#ifndef CROG_SUB0PUB_BENCHMARK_HPP
+#define CROG_SUB0PUB_BENCHMARK_HPP
+
+#include "sub0pub/sub0pub.hpp"
+
+#include <array> //< std::array
+#include <chrono> //< std::chrono::steady_clock
+#include <cmath> //< std::ceil
+#include <string> //< std::string
+#include <vector> //< std::vector
+
+namespace sub0
+{
+    namespace benchmark
+    {
+        /** Prevent the compiler optimising away a computed value
+        */
+        template< typename Type_t >
+        inline void doNotOptimize( const Type_t& value )
+        {
+#if defined(__GNUC__)
+            asm volatile( "" : : "r,m"(value) : "memory" );
+#else
+            static volatile const void* sink;
+            sink = &value;
+#endif
+        }
+
+        /** Latency percentiles in nanoseconds
+        */
+        struct Percentiles
+        {
+            uint64_t p50;
+            uint64_t p90;
+            uint64_t p99;
+            uint64_t p999;
+            uint64_t max;
+        };
+
+        /** Log-linear histogram of nanosecond latencies in the style of HdrHistogram
+         * @remark Values are bucketed by power of two, each split into 2^cSubBucketBits linear sub-buckets so the
+         *  relative error of a reported percentile is below 2^-cSubBucketBits
+         */
+        class Histogram
+        {
+        public:
+            static const uint32_t cSubBucketBits = 5U;
+            static const uint32_t cSubBucketCount = 1U << cSubBucketBits;
+            static const uint32_t cBucketCount = (64U - cSubBucketBits + 1U) * cSubBucketCount;
+
+        public:
+            Histogram()
+                : counts_(), count_(0U), max_(0U)
+            {}
+
+            void record( const uint64_t value )
+            {
+                ++counts_[index( value )];
+                ++count_;
+                max_ = std::max( max_, value );
+            }
+
+            uint64_t count() const
+            { return count_; }
+
+            /** @return Highest value equivalent to the value at 'fraction' of recorded values e.g. 0.99
+            */
+            uint64_t percentile( const double fraction ) const
+            {
+                const uint64_t rank = std::max<uint64_t>( 1U, static_cast<uint64_t>( std::ceil( fraction * double(count_) ) ) );
+                uint64_t cumulative = 0U;
+                for ( uint32_t iBucket = 0U; iBucket < cBucketCount; ++iBucket )
+                {
+                    cumulative += counts_[iBucket];
+                    if ( cumulative >= rank )
+                        return std::min( highest( iBucket ), max_ );
+                }
+                return max_;
+            }
+
+            Percentiles percentiles() const
+            { return Percentiles{ percentile(0.5), percentile(0.9), percentile(0.99), percentile(0.999), max_ }; }
+
+        private:
+            static uint32_t index( const uint64_t value )
+            {
+                if ( value < cSubBucketCount )
+                    return static_cast<uint32_t>( value );
+                uint32_t msb = 0U;
+                for ( uint64_t remaining = value; remaining > 1U; remaining >>= 1U )
+                    ++msb;
+                const uint32_t shift = msb - cSubBucketBits;
+                return (shift + 1U) * cSubBucketCount + static_cast<uint32_t>( (value >> shift) - cSubBucketCount );
+            }
+
+            static uint64_t highest( const uint32_t iBucket )
+            {
+                if ( iBucket < cSubBucketCount )
+                    return iBucket;
+                const uint32_t shift = (iBucket / cSubBucketCount) - 1U;
+                const uint64_t mantissa = (iBucket % cSubBucketCount) + cSubBucketCount;
+                return ((mantissa + 1U) << shift) - 1U;
+            }
+
+        private:
+            std::array<uint64_t, cBucketCount> counts_;
+            uint64_t count_;
+            uint64_t max_;
+        };
+
+        /** Measurement of a single benchmark configuration
+        */
+        struct Result
+        {
+            std::string name; ///< Benchmark name e.g. "broker.publish"
+            std::string params; ///< Parameters of the run e.g. "subscribers=4"
+            uint64_t iterations; ///< Count of timed calls of the benchmark body
+            double seconds; ///< Total elapsed time of all iterations
+            uint64_t itemsPerIteration; ///< Messages processed per iteration
+            uint64_t bytesPerIteration; ///< Bytes processed per iteration
+
+            Percentiles latency = {}; ///< Per-item latency, all zero unless measured with a Histogram
+
+            double nsPerIteration() const { return seconds * 1e9 / double(iterations); }
+            double itemsPerSecond() const { return double(itemsPerIteration * iterations) / seconds; }
+            double bytesPerSecond() const { return double(bytesPerIteration * iterations) / seconds; }
+        };
+
+        /** Runs benchmark bodies and collects their results
+        */
+        class Runner
+        {
+        public:
+            /** @param filter  Only benchmarks whose name contains this sub-string are run
+             * @param minSeconds  Minimum measured duration of each benchmark configuration
+             */
+            Runner( const std::string& filter, const double minSeconds )
+                : filter_(filter)
+                , minSeconds_(minSeconds)
+                , results_()
+                , failureCount_(0U)
+            {}
+
+            /** @return True if benchmark 'name' is selected by the filter
+            */
+            bool selected( const std::string& name ) const
+            { return name.find(filter_) != std::string::npos; }
+
+            /** Time repeated calls of 'body' until the minimum duration has elapsed
+             * @param name  Benchmark name
+             * @param params  Parameters of the configuration being measured
+             * @param itemsPerCall  Count of messages processed by each call of 'body'
+             * @param bytesPerCall  Count of bytes processed by each call of 'body'
+             * @param body  Callable to be measured
+             */
+            template< typename Body >
+            void measure( const std::string& name, const std::string& params, const uint64_t itemsPerCall, const uint64_t bytesPerCall, Body&& body )
+            {
+                if ( !selected(name) )
+                    return;
+
+                body(); //< Warm-up
+
+                for ( uint64_t iterations = 1U; ; )
+                {
+                    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                    for ( uint64_t iIteration = 0U; iIteration < iterations; ++iIteration )
+                        body();
+                    const double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+                    if ( seconds >= minSeconds_ || iterations >= (uint64_t(1U) << 40U) )
+                    {
+                        results_.push_back( Result{ name, params, iterations, seconds, itemsPerCall, bytesPerCall } );
+                        report( results_.back() );
+                        return;
+                    }
+
+                    // Scale towards the minimum duration with headroom, at most 100x per step
+                    const double scale = (seconds > 0.0) ? std::min( 1.4 * minSeconds_ / seconds, 100.0 ) : 100.0;
+                    iterations = std::max<uint64_t>( iterations + 1U, static_cast<uint64_t>( double(iterations) * scale ) );
+                }
+            }
+
+            /** Record a result measured by the benchmark itself e.g. Multi-threaded runs
+            */
+            void add( const Result& result )
+            {
+                if ( !selected(result.name) )
+                    return;
+                results_.push_back( result );
+                report( results_.back() );
+            }
+
+            /** Report a benchmark whose verification failed, the run exits with failure
+            */
+            void fail( const std::string& name, const std::string& params, const std::string& reason );
+
+            const std::vector<Result>& results() const
+            { return results_; }
+
+            /** @return Count of fail() reports
+            */
+            size_t failureCount() const
+            { return failureCount_; }
+
+            /** @return Minimum measured duration of each benchmark configuration
+            */
+            double minSeconds() const
+            { return minSeconds_; }
+
+        private:
+            /** Human readable progress to stderr, stdout is reserved for JSON
+            */
+            static void report( const Result& result );
+
+        private:
+            std::string filter_;
+            double minSeconds_;
+            std::vector<Result> results_;
+            size_t failureCount_;
+        };
+
+        typedef void (*BenchmarkFunction)( Runner& runner );
+
+        /** @return List of benchmark functions registered with SUB0_BENCHMARK
+        */
+        std::vector<BenchmarkFunction>& registry();
+
+        /** @return Count of heap allocations made by the calling thread
+         * @remark Counted by the replacement operator new and malloc of allocation.cpp
+         */
+        uint64_t allocationCount();
+
+        /** Static registration of a benchmark function
+        */
+        struct Registration
+        {
+            explicit Registration( BenchmarkFunction function )
+            { registry().push_back( function ); }
+        };
+
+        /** Memory output stream for serialising into a recording
+        */
+        class MemoryOStream : public utility::OStream
+        {
+        public:
+            StreamSize write( const char* const buffer, const StreamSize bufferCount ) override
+            {
+                bytes.insert( bytes.end(), buffer, buffer + bufferCount );
+                return bufferCount;
+            }
+
+            void flush() override
+            {}
+
+            std::vector<char> bytes;
+        };
+
+        /** Memory input stream reading back a recording
+        */
+        class MemoryIStream : public utility::IStream
+        {
+        public:
+            MemoryIStream( const char* const data, const size_t size )
+                : data_(data), size_(size), position_(0U)
+            {}
+
+            void rewind()
+            { position_ = 0U; }
+
+            StreamSize read( char* const buffer, const StreamSize bufferCount ) override
+            {
+                const StreamSize count = static_cast<StreamSize>( std::min<size_t>( bufferCount, size_ - position_ ) );
+                std::memcpy( buffer, data_ + position_, count );
+                position_ += count;
+                return count;
+            }
+
+            StreamSize readline( char* const, const StreamSize ) override
+            { return 0U; }
+
+            StreamSize ignore( const StreamSize bufferCount ) override
+            {
+                const StreamSize count = static_cast<StreamSize>( std::min<size_t>( bufferCount, size_ - position_ ) );
+                position_ += count;
+                return count;
+            }
+
+            StreamSize ignore( const StreamSize bufferCount, const char ) override
+            { return ignore( bufferCount ); }
+
+            bool isEof() override
+            { return position_ == size_; }
+
+        private:
+            const char* data_;
+            size_t size_;
+            size_t position_;
+        };
+
+        /** Fixed size message payload
+         * @tparam cBytes  Size of the payload in bytes
+         * @tparam cTag  Distinguishes otherwise identical payload types
+         */
+        template< size_t cBytes, uint32_t cTag = 0U >
+        struct Payload
+        {
+            uint8_t bytes[cBytes];
+        };
+
+        /** Assign wire type identifier and name to a Data type for the lifetime of the object
+        */
+        template< typename Data >
+        class TypeName : public Publish<Data>
+        {
+        public:
+            TypeName( const uint32_t typeId, const char* const typeName )
+                : Publish<Data>( typeId, typeName )
+            {}
+        };
+
+    } // END: benchmark
+} // END: sub0
+
+/** Register a benchmark function of signature `void(sub0::benchmark::Runner&)`
+*/
+#define SUB0_BENCHMARK(function) \
+    static const sub0::benchmark::Registration function##_registration( &function )
+
+#endif
@@ -0,0 +1,144 @@
+/** Benchmark of in-process broker publish
+ * @remark Measures Broker<Data>::publish fan-out to 1..Broker::cMaxSubscriptions subscribers, the cost of a
+ *  Subscribe<Data>::filter() override, SubscribeAll<> compared to separate Subscribe<Data> objects, and the cost of
+ *  retaining publishes with SUB0_HISTORY
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#include "benchmark.hpp"
+
+#include <memory> //< std::unique_ptr
+
+namespace
+{
+    using namespace sub0::benchmark;
+
+    typedef Payload<16U> Data;
+    typedef Payload<16U, 1U> DataB;
+    typedef Payload<16U, 2U> DataC;
+    typedef Payload<16U, 3U> DataD;
+    typedef Payload<16U, 4U> Retained;
+
+} // END: anonymous
+
+SUB0_HISTORY( Retained, 16 );
+
+namespace
+{
+    const uint32_t cMessageCount = 1024U * 1024U; ///< Publishes per iteration
+
+    class Sink : public sub0::Subscribe<Data>
+    {
+    public:
+        void receive( const Data& data ) override
+        { sum_ += data.bytes[0]; }
+
+        uint64_t sum_ = 0U;
+    };
+
+    /** Accepts every other message by content
+    */
+    class FilteredSink : public Sink
+    {
+    public:
+        bool filter( const Data& data ) override
+        { return (data.bytes[1] & 1U) == 0U; }
+    };
+
+    class SinkAll : public sub0::SubscribeAll<Data, DataB, DataC, DataD>
+    {
+    public:
+        void receive( const Data& data ) override { sum_ += data.bytes[0]; }
+        void receive( const DataB& data ) override { sum_ += data.bytes[0]; }
+        void receive( const DataC& data ) override { sum_ += data.bytes[0]; }
+        void receive( const DataD& data ) override { sum_ += data.bytes[0]; }
+
+        uint64_t sum_ = 0U;
+    };
+
+    template< typename Data_t >
+    class SinkOne : public sub0::Subscribe<Data_t>
+    {
+    public:
+        void receive( const Data_t& data ) override
+        { sum_ += data.bytes[0]; }
+
+        uint64_t sum_ = 0U;
+    };
+
+    /** Publish cMessageCount messages varying in content
+    */
+    template< typename Data_t >
+    void publishAll( const sub0::Publish<Data_t>& source )
+    {
+        Data_t data = {};
+        for ( uint32_t iMessage = 0U; iMessage < cMessageCount; ++iMessage )
+        {
+            data.bytes[1] = static_cast<uint8_t>( iMessage );
+            source.publish( data );
+        }
+    }
+
+    void broker( Runner& runner )
+    {
+        if ( !runner.selected( "broker." ) )
+            return;
+
+        sub0::Publish<Data> source;
+
+        for ( uint32_t subscriberCount = 1U; subscriberCount <= sub0::Broker<Data>::cMaxSubscriptions; subscriberCount *= 2U )
+        {
+            std::vector< std::unique_ptr<Sink> > sinks;
+            for ( uint32_t iSubscriber = 0U; iSubscriber < subscriberCount; ++iSubscriber )
+                sinks.emplace_back( new Sink() );
+
+            runner.measure( "broker.fanout", "subscribers=" + std::to_string(subscriberCount)
+                          , cMessageCount, cMessageCount * sizeof(Data), [&] { publishAll( source ); } );
+        }
+
+        {
+            Sink sink;
+            runner.measure( "broker.filter", "filter=default", cMessageCount, cMessageCount * sizeof(Data), [&] { publishAll( source ); } );
+        }
+        {
+            FilteredSink sink;
+            runner.measure( "broker.filter", "filter=half", cMessageCount, cMessageCount * sizeof(Data), [&] { publishAll( source ); } );
+        }
+
+        // Round-robin over 4 types, as each type is a separate Broker the subscriber layout is all that differs
+        sub0::Publish<DataB> sourceB;
+        sub0::Publish<DataC> sourceC;
+        sub0::Publish<DataD> sourceD;
+        const auto publishTypes = [&]
+        {
+            publishAll( source );
+            publishAll( sourceB );
+            publishAll( sourceC );
+            publishAll( sourceD );
+        };
+        {
+            SinkOne<Data> sinkA;
+            SinkOne<DataB> sinkB;
+            SinkOne<DataC> sinkC;
+            SinkOne<DataD> sinkD;
+            runner.measure( "broker.subscribe_all", "subscribers=separate", 4U * cMessageCount, 4U * cMessageCount * sizeof(Data), publishTypes );
+        }
+        {
+            SinkAll sink;
+            runner.measure( "broker.subscribe_all", "subscribers=SubscribeAll", 4U * cMessageCount, 4U * cMessageCount * sizeof(Data), publishTypes );
+        }
+
+        {
+            Sink sink;
+            runner.measure( "broker.history", "depth=0", cMessageCount, cMessageCount * sizeof(Data), [&] { publishAll( source ); } );
+        }
+        {
+            sub0::Publish<Retained> sourceRetained;
+            SinkOne<Retained> sink;
+            runner.measure( "broker.history", "depth=16", cMessageCount, cMessageCount * sizeof(Retained), [&] { publishAll( sourceRetained ); } );
+        }
+    }
+
+} // END: anonymous
+
+SUB0_BENCHMARK( broker );
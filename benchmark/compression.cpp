@@ -0,0 +1,231 @@
+/** Benchmark of block compression of a recording
+ * @remark Measures raw codec throughput and end-to-end decoding of a compressed telemetry-like recording. The codec
+ *  round trip and the messages decoded are verified against the recording before timing.
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#include "benchmark.hpp"
+
+#include "sub0pub/compression.hpp"
+#include "sub0pub/parallel.hpp"
+
+#include <cstdio> //< std::snprintf
+#include <cstring> //< std::memcmp
+#include <string> //< std::to_string
+#include <thread> //< std::thread::hardware_concurrency
+
+namespace
+{
+    using namespace sub0::benchmark;
+
+    typedef sub0::CompressedSerialisation<> Compressed;
+
+    /** Slowly varying sensor state, representative of recorded telemetry
+    */
+    struct Telemetry
+    {
+        uint64_t timestamp;
+        uint32_t sequence;
+        uint32_t status;
+        float position[3];
+        float velocity[3];
+    };
+
+    const uint32_t cMessageCount = 256U * 1024U; ///< Frames in the recording
+    const size_t cBlockBytes = 64U * 1024U; ///< Uncompressed size of each block
+
+    template< typename Protocol >
+    class Recorder : public sub0::StreamSerializer<Protocol>
+                   , public sub0::ForwardSubscribe< Telemetry, Recorder<Protocol> >
+    {
+    public:
+        Recorder( MemoryOStream& stream )
+            : sub0::StreamSerializer<Protocol>( stream )
+        {}
+    };
+
+    class StreamDecoder : public sub0::StreamDeserializer<Compressed>
+                        , public sub0::ForwardPublish< Telemetry, StreamDecoder >
+    {
+    public:
+        StreamDecoder( MemoryIStream& stream )
+            : sub0::StreamDeserializer<Compressed>( stream )
+        {}
+    };
+
+    class ParallelDecoder : public sub0::ParallelDeserializer<Compressed>
+                          , public sub0::ForwardPublish< Telemetry, ParallelDecoder >
+    {
+    public:
+        ParallelDecoder( const std::vector<char>& recording )
+            : sub0::ParallelDeserializer<Compressed>( recording.data(), recording.size() )
+        {}
+    };
+
+    class Sink : public sub0::Subscribe<Telemetry>
+    {
+    public:
+        void receive( const Telemetry& data ) override
+        { sequence_ += data.sequence; }
+
+        uint64_t sequence_ = 0U;
+    };
+
+    /** @return Message 'iMessage' of the recording
+    */
+    Telemetry telemetry( const uint32_t iMessage )
+    {
+        const float t = float(iMessage) * 0.001f;
+        return Telemetry{ 1000U * iMessage, iMessage, (iMessage / 4096U) & 3U, { t, 2.0f * t, 10.0f }, { 1.0f, 2.0f, 0.0f } };
+    }
+
+    /** Compares received messages in order with those recorded
+    */
+    class Checker : public sub0::Subscribe<Telemetry>
+    {
+    public:
+        void receive( const Telemetry& data ) override
+        {
+            const Telemetry expected = telemetry( static_cast<uint32_t>( receivedCount_ ) );
+            mismatchCount_ += (std::memcmp( &data, &expected, sizeof(data) ) == 0) ? 0U : 1U;
+            sequence_ += data.sequence;
+            ++receivedCount_;
+        }
+
+        uint64_t receivedCount_ = 0U;
+        uint64_t mismatchCount_ = 0U;
+        uint64_t sequence_ = 0U;
+    };
+
+    /** Report a Checker which has not received every recorded message
+    */
+    void check( Runner& runner, const char* const name, const std::string& params, const Checker& checker )
+    {
+        const uint64_t expectedSequence = uint64_t(cMessageCount) * (cMessageCount - 1U) / 2U;
+        if ( checker.receivedCount_ != cMessageCount || checker.mismatchCount_ != 0U || checker.sequence_ != expectedSequence )
+        {
+            runner.fail( name, params, std::to_string( checker.receivedCount_ ) + " messages of " + std::to_string( cMessageCount )
+                + ", " + std::to_string( checker.mismatchCount_ ) + " differ, sequence sum " + std::to_string( checker.sequence_ )
+                + " of " + std::to_string( expectedSequence ) );
+        }
+    }
+
+    template< typename Protocol >
+    void record( MemoryOStream& recording )
+    {
+        Recorder<Protocol> recorder( recording );
+        if constexpr ( std::is_same<Protocol, Compressed>::value )
+        {
+            typename Compressed::Writer::Config config;
+            config.blockBytes = cBlockBytes;
+            recorder.configure( config );
+        }
+        recorder.open();
+
+        sub0::Publish<Telemetry> source;
+        for ( uint32_t iMessage = 0U; iMessage < cMessageCount; ++iMessage )
+            source.publish( telemetry( iMessage ) );
+        recorder.close();
+    }
+
+    void blockCompression( Runner& runner )
+    {
+        if ( !runner.selected( "compression." ) )
+            return;
+
+        TypeName<Telemetry> name( 0x200, "Telemetry" );
+
+        MemoryOStream raw;
+        record<sub0::DefaultSerialisation>( raw );
+        MemoryOStream compressed;
+        record<Compressed>( compressed );
+
+        char params[64];
+        std::snprintf( params, sizeof(params), "block=%zu ratio=%.2f", cBlockBytes, double(raw.bytes.size()) / double(compressed.bytes.size()) );
+
+        // Codec alone over the uncompressed recording
+        const size_t blockCount = (raw.bytes.size() + cBlockBytes - 1U) / cBlockBytes;
+        std::vector<char> blocks( blockCount * sub0::lz::compressBound(cBlockBytes) );
+        std::vector<size_t> blockSizes( blockCount );
+        const auto compress = [&]
+        {
+            for ( size_t iBlock = 0U; iBlock < blockCount; ++iBlock )
+            {
+                const size_t offset = iBlock * cBlockBytes;
+                blockSizes[iBlock] = sub0::lz::compress( raw.bytes.data() + offset, std::min( cBlockBytes, raw.bytes.size() - offset )
+                                                       , blocks.data() + iBlock * sub0::lz::compressBound(cBlockBytes) );
+            }
+        };
+
+        std::vector<char> decompressed( raw.bytes.size() );
+        size_t invalidCount = 0U; ///< Blocks decompress() rejected
+        const auto decompress = [&]
+        {
+            for ( size_t iBlock = 0U; iBlock < blockCount; ++iBlock )
+            {
+                const size_t offset = iBlock * cBlockBytes;
+                const bool valid = sub0::lz::decompress( blocks.data() + iBlock * sub0::lz::compressBound(cBlockBytes), blockSizes[iBlock]
+                                                       , decompressed.data() + offset, std::min( cBlockBytes, raw.bytes.size() - offset ) );
+                invalidCount += valid ? 0U : 1U;
+            }
+        };
+
+        compress();
+        decompress();
+        if ( invalidCount != 0U || std::memcmp( decompressed.data(), raw.bytes.data(), raw.bytes.size() ) != 0 )
+            runner.fail( "compression.lz_decompress", params, std::to_string( invalidCount ) + " of " + std::to_string( blockCount ) + " blocks invalid, or output differs from input" );
+
+        runner.measure( "compression.lz_compress", params, blockCount, raw.bytes.size(), compress );
+        runner.measure( "compression.lz_decompress", params, blockCount, raw.bytes.size(), decompress );
+        doNotOptimize( invalidCount );
+
+        // End-to-end decoding, throughput reported against the uncompressed size
+        {
+            MemoryIStream stream( compressed.bytes.data(), compressed.bytes.size() );
+            StreamDecoder decoder( stream );
+            const auto decode = [&]
+            {
+                stream.rewind();
+                decoder.open();
+                while ( !stream.isEof() )
+                    decoder.update();
+                while ( decoder.update() ) {}
+            };
+
+            {
+                Checker checker;
+                decode();
+                check( runner, "compression.stream_deserializer", params, checker );
+            }
+
+            Sink sink;
+            runner.measure( "compression.stream_deserializer", params, cMessageCount, raw.bytes.size(), decode );
+            doNotOptimize( sink.sequence_ );
+        }
+
+        {
+            ParallelDecoder decoder( compressed.bytes );
+            sub0::ParallelDeserializer<Compressed>::Config config;
+            config.workerCount = static_cast<uint_fast16_t>( std::max( std::thread::hardware_concurrency(), 1U ) );
+            decoder.configure( config );
+            decoder.open();
+            const std::string parallelParams = std::string(params) + " workers=" + std::to_string(config.workerCount);
+
+            {
+                Checker checker;
+                decoder.update();
+                check( runner, "compression.parallel_ordered", parallelParams, checker );
+            }
+
+            Sink sink;
+            runner.measure( "compression.parallel_ordered", parallelParams, cMessageCount, raw.bytes.size(), [&]
+            {
+                decoder.update();
+            } );
+            doNotOptimize( sink.sequence_ );
+        }
+    }
+
+} // END: anonymous
+
+SUB0_BENCHMARK( blockCompression );
@@ -0,0 +1,244 @@
+/** Benchmark of delta encoding of consecutive messages
+ * @remark Compares DeltaSerialisation against the plain BinaryWriter of DefaultSerialisation for messages which are
+ *  unchanged, change in a few fields or change entirely. Each recording is decoded and compared to the published
+ *  messages before timing, including by a reader joining mid-stream which must resync at the next keyframe. Bytes
+ *  per second are of the uncompressed payloads.
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#include "benchmark.hpp"
+
+#include "sub0pub/delta.hpp"
+
+#include <cstdio> //< std::snprintf
+#include <cstring> //< std::memcmp
+#include <string> //< std::to_string
+
+namespace bench
+{
+    /** Sensor state of which few fields change between consecutive messages
+    */
+    struct Telemetry
+    {
+        uint64_t timestamp;
+        uint32_t sequence;
+        uint32_t status;
+        float state[60];
+    };
+}
+
+SUB0_DELTA_ENCODING( bench::Telemetry )
+
+namespace
+{
+    using namespace sub0::benchmark;
+    using bench::Telemetry;
+
+    typedef sub0::DeltaSerialisation Delta;
+
+    const uint32_t cMessageCount = 32U * 1024U; ///< Messages per iteration
+    const uint32_t cJoinIndex = cMessageCount / 2U + 1U; ///< First message recorded after a late reader joins
+
+    /** Difference between consecutive messages
+    */
+    enum class Change
+    {
+          Unchanged ///< Every message equal to the first
+        , Sparse ///< Timestamp, sequence and one state value
+        , Full ///< Every byte
+    };
+
+    template< typename Protocol >
+    class Recorder : public sub0::StreamSerializer<Protocol>
+                   , public sub0::ForwardSubscribe< Telemetry, Recorder<Protocol> >
+    {
+    public:
+        Recorder( MemoryOStream& stream )
+            : sub0::StreamSerializer<Protocol>( stream )
+        {}
+    };
+
+    template< typename Protocol >
+    class Decoder : public sub0::StreamDeserializer<Protocol>
+                  , public sub0::ForwardPublish< Telemetry, Decoder<Protocol> >
+    {
+    public:
+        Decoder( MemoryIStream& stream )
+            : sub0::StreamDeserializer<Protocol>( stream )
+        {}
+    };
+
+    class Sink : public sub0::Subscribe<Telemetry>
+    {
+    public:
+        void receive( const Telemetry& data ) override
+        { doNotOptimize( data ); }
+    };
+
+    /** Compares received messages with those published from 'first'
+    */
+    class Checker : public sub0::Subscribe<Telemetry>
+    {
+    public:
+        Checker( const std::vector<Telemetry>& messages, const size_t first )
+            : messages_(messages), next_(first)
+        {}
+
+        void receive( const Telemetry& data ) override
+        {
+            const bool isEqual = next_ < messages_.size() && std::memcmp( &data, &messages_[next_], sizeof(data) ) == 0;
+            mismatchCount_ += isEqual ? 0U : 1U;
+            ++receivedCount_;
+            ++next_;
+        }
+
+        const std::vector<Telemetry>& messages_;
+        size_t next_;
+        uint64_t receivedCount_ = 0U;
+        uint64_t mismatchCount_ = 0U;
+    };
+
+    std::vector<Telemetry> generate( const Change change )
+    {
+        std::vector<Telemetry> messages( cMessageCount );
+        for ( uint32_t iMessage = 0U; iMessage < cMessageCount; ++iMessage )
+        {
+            Telemetry& message = messages[iMessage];
+            switch ( change )
+            {
+            case Change::Unchanged:
+                message = Telemetry{ 1000U, 1U, 0x10U, {} };
+                for ( uint32_t iState = 0U; iState < 60U; ++iState )
+                    message.state[iState] = float(iState);
+                break;
+            case Change::Sparse:
+                message = (iMessage != 0U) ? messages[iMessage - 1U] : Telemetry{ 0U, 0U, 0x10U, {} };
+                message.timestamp = 1000U * iMessage;
+                message.sequence = iMessage;
+                message.state[(iMessage * 7U) % 60U] += 0.25f;
+                break;
+            case Change::Full:
+                for ( size_t iByte = 0U; iByte < sizeof(message); ++iByte )
+                    reinterpret_cast<uint8_t*>(&message)[iByte] = static_cast<uint8_t>( iMessage * 131U + iByte ); //< Odd step changes every byte
+                break;
+            }
+        }
+        return messages;
+    }
+
+    /** @return Index of the first message from 'index' written as a keyframe, messages.size() for none
+     * @param keyframeInterval  DeltaWriter::Config::keyframeInterval, a keyframe is followed by that many deltas
+     */
+    size_t nextKeyframe( const Change change, const uint32_t keyframeInterval, const size_t index, const size_t size )
+    {
+        if ( change == Change::Full ) //< Deltas do not encode smaller
+            return index;
+        if ( keyframeInterval == 0U )
+            return (index == 0U) ? 0U : size;
+        const size_t period = keyframeInterval + 1U;
+        return std::min( (index + period - 1U) / period * period, size );
+    }
+
+    template< typename Protocol >
+    void measure( Runner& runner, const std::string& params, const std::vector<Telemetry>& messages
+                , const typename Protocol::Writer::Config& config, const Change change, const uint32_t keyframeInterval )
+    {
+        sub0::Publish<Telemetry> source;
+
+        MemoryOStream recording;
+        recording.bytes.reserve( messages.size() * (sizeof(Telemetry) + 32U) );
+        size_t joinOffset = 0U; ///< Recording bytes before the late reader joins
+        const auto record = [&]
+        {
+            recording.bytes.clear();
+            for ( size_t iMessage = 0U; iMessage < messages.size(); ++iMessage )
+            {
+                if ( iMessage == cJoinIndex )
+                    joinOffset = recording.bytes.size();
+                source.publish( messages[iMessage] );
+            }
+        };
+
+        const uint64_t payloadBytes = messages.size() * sizeof(Telemetry);
+        {
+            Recorder<Protocol> recorder( recording );
+            recorder.configure( config );
+            recorder.open();
+            record();
+        }
+
+        // A reader from the start receives every message, a late reader resyncs from the next keyframe
+        const std::pair<size_t, size_t> readers[] = { { 0U, 0U }, { joinOffset, cJoinIndex } }; ///< Recording offset and message index
+        for ( const std::pair<size_t, size_t>& reader : readers )
+        {
+            const size_t first = nextKeyframe( change, keyframeInterval, reader.second, messages.size() );
+            Checker checker( messages, first );
+            MemoryIStream stream( recording.bytes.data() + reader.first, recording.bytes.size() - reader.first );
+            Decoder<Protocol> decoder( stream );
+            decoder.open();
+            while ( decoder.update() ) {}
+
+            if ( checker.receivedCount_ != messages.size() - first || checker.mismatchCount_ != 0U )
+            {
+                runner.fail( "delta.read", params, "reader from message " + std::to_string( reader.second ) + " received "
+                    + std::to_string( checker.receivedCount_ ) + " of " + std::to_string( messages.size() - first )
+                    + ", " + std::to_string( checker.mismatchCount_ ) + " differ" );
+            }
+        }
+
+        {
+            Recorder<Protocol> recorder( recording );
+            recorder.configure( config );
+
+            char ratio[32];
+            std::snprintf( ratio, sizeof(ratio), " ratio=%.2f", double(payloadBytes) / double(recording.bytes.size()) );
+            runner.measure( "delta.write", params + ratio, messages.size(), payloadBytes, [&]
+            {
+                recorder.open(); //< Stream starts from keyframes
+                record();
+            } );
+        }
+
+        Sink sink;
+        MemoryIStream stream( recording.bytes.data(), recording.bytes.size() );
+        Decoder<Protocol> decoder( stream );
+        runner.measure( "delta.read", params, messages.size(), payloadBytes, [&]
+        {
+            stream.rewind();
+            decoder.open();
+            while ( decoder.update() ) {}
+            decoder.close(); //< Next pass starts from keyframes
+        } );
+    }
+
+    void deltaEncoding( Runner& runner )
+    {
+        if ( !runner.selected( "delta." ) )
+            return;
+
+        TypeName<Telemetry> name( 0xA00, "Telemetry" );
+
+        const std::pair<Change, const char*> changes[] = {
+              { Change::Unchanged, "change=unchanged" }
+            , { Change::Sparse, "change=sparse" }
+            , { Change::Full, "change=full" } };
+        for ( const std::pair<Change, const char*>& change : changes )
+        {
+            const std::vector<Telemetry> messages = generate( change.first );
+            measure<sub0::DefaultSerialisation>( runner, std::string( change.second ) + " memcpy", messages, {}
+                                              , Change::Full, 0U ); //< Every frame is a full payload, as a keyframe
+
+            const uint32_t keyframeIntervals[] = { 100U, 0U };
+            for ( const uint32_t keyframeInterval : keyframeIntervals )
+            {
+                Delta::Writer::Config config;
+                config.keyframeInterval = keyframeInterval;
+                measure<Delta>( runner, std::string( change.second ) + " keyframes=" + std::to_string( keyframeInterval )
+                              , messages, config, change.first, keyframeInterval );
+            }
+        }
+    }
+
+} // END: anonymous
+
+SUB0_BENCHMARK( deltaEncoding );
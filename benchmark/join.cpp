@@ -0,0 +1,122 @@
+/** Benchmark of Join matching of topics published at different rates
+ * @remark Three inputs keyed by timestamp, the fastest publishing four times per set, for each Join::Policy. Matched
+ *  sets and Join::dropCount() are verified against those expected of the policy.
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#include "benchmark.hpp"
+
+#include "sub0pub/join.hpp"
+
+#include <string> //< std::to_string
+
+namespace
+{
+    using namespace sub0::benchmark;
+
+    struct Pose
+    {
+        uint64_t timestamp;
+        float position[3];
+        float orientation[4];
+    };
+
+    struct Imu
+    {
+        uint64_t timestamp;
+        float acceleration[3];
+        float rate[3];
+    };
+
+    struct Odometry
+    {
+        uint64_t timestamp;
+        float velocity[3];
+    };
+
+} // END: anonymous
+
+SUB0_JOIN_KEY( Pose, timestamp );
+SUB0_JOIN_KEY( Imu, timestamp );
+SUB0_JOIN_KEY( Odometry, timestamp );
+
+namespace
+{
+    const uint32_t cSetCount = 256U * 1024U; ///< Pose publishes per iteration
+    const uint64_t cPeriod = 4000U; ///< Key step between Pose publishes
+
+    typedef sub0::Join<Pose, Imu, Odometry> Fusion;
+
+    class Fuser : public Fusion
+    {
+    public:
+        explicit Fuser( const Fusion::Config& config )
+            : Fusion( config )
+            , tolerance_( config.tolerance )
+        {}
+
+        void receive( const Pose& pose, const Imu& imu, const Odometry& odometry ) override
+        {
+            ++matchCount_;
+            const bool isMatched = (odometry.timestamp == pose.timestamp) //< Published together
+                && imu.timestamp >= pose.timestamp && imu.timestamp - pose.timestamp <= tolerance_;
+            mismatchCount_ += isMatched ? 0U : 1U;
+        }
+
+        uint64_t tolerance_;
+        uint64_t matchCount_ = 0U;
+        uint64_t mismatchCount_ = 0U; ///< Sets with keys further apart than the policy allows
+    };
+
+    void join( Runner& runner )
+    {
+        if ( !runner.selected( "join." ) )
+            return;
+
+        sub0::Publish<Pose> poseSource;
+        sub0::Publish<Imu> imuSource;
+        sub0::Publish<Odometry> odometrySource;
+        uint64_t time = 0U;
+        uint64_t setCount = 0U;
+        const auto publish = [&]
+        {
+            for ( uint32_t iSet = 0U; iSet < cSetCount; ++iSet, time += cPeriod )
+            {
+                imuSource.publish( Imu{ time, {}, {} } );
+                odometrySource.publish( Odometry{ time, {} } );
+                poseSource.publish( Pose{ time, {}, {} } );
+                for ( uint64_t iImu = 1U; iImu < 4U; ++iImu ) //< In key order, Imu between the slower inputs
+                    imuSource.publish( Imu{ time + iImu * (cPeriod / 4U), {}, {} } );
+            }
+            setCount += cSetCount;
+        };
+
+        const std::pair<Fusion::Policy, const char*> policies[] = {
+              { Fusion::Policy::Exact, "policy=exact" }
+            , { Fusion::Policy::Nearest, "policy=nearest" }
+            , { Fusion::Policy::Latest, "policy=latest" } };
+        for ( const std::pair<Fusion::Policy, const char*>& policy : policies )
+        {
+            Fusion::Config config;
+            config.policy = policy.first;
+            config.tolerance = cPeriod / 2U;
+            Fuser fuser( config );
+            setCount = 0U;
+            runner.measure( "join.publish", policy.second, 6U * cSetCount, 0U, publish );
+
+            // Exact and Nearest match each Pose to the Imu of equal key, the 3 later Imu are dropped by the next match.
+            // Latest also pairs the 2 later Imu within tolerance with the newest Pose, and never drops.
+            const bool isLatest = (policy.first == Fusion::Policy::Latest);
+            const uint64_t expectedMatches = isLatest ? 3U * setCount : setCount;
+            const uint64_t expectedDrops = (isLatest || setCount == 0U) ? 0U : 3U * (setCount - 1U);
+            if ( fuser.matchCount_ != expectedMatches || fuser.mismatchCount_ != 0U || fuser.dropCount() != expectedDrops )
+            {
+                runner.fail( "join.publish", policy.second, std::to_string( fuser.matchCount_ ) + " sets of " + std::to_string( expectedMatches )
+                    + ", " + std::to_string( fuser.mismatchCount_ ) + " mismatched, " + std::to_string( fuser.dropCount() ) + " drops of " + std::to_string( expectedDrops ) );
+            }
+        }
+    }
+
+} // END: anonymous
+
+SUB0_BENCHMARK( join );
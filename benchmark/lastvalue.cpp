@@ -0,0 +1,121 @@
+/** Benchmark of the LastValue seqlock cache
+ * @remark Measures publish into a LastValue and uncontended read, then one publishing thread against an increasing
+ *  count of polling reader threads reporting both publish and aggregate read rates
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#include "benchmark.hpp"
+
+#include "sub0pub/lastvalue.hpp"
+
+#include <atomic> //< std::atomic
+#include <thread> //< std::thread
+
+namespace
+{
+    using namespace sub0::benchmark;
+
+    /** Pose sized message as read by a render thread
+    */
+    struct Pose
+    {
+        uint64_t timestamp;
+        float position[3];
+        float orientation[4];
+    };
+
+    const uint32_t cMessageCount = 1024U * 1024U; ///< Publishes or reads per iteration
+
+    /** Publish on this thread while 'readerCount' threads read, for the minimum duration of the runner
+    */
+    void contended( Runner& runner, const unsigned readerCount )
+    {
+        sub0::Publish<Pose> source;
+        sub0::LastValue<Pose> cache;
+        source.publish( Pose{} );
+
+        std::atomic<bool> isRunning( true );
+        std::vector<uint64_t> readCounts( readerCount ); //< Written once each reader stops
+        std::vector<std::thread> readers;
+        for ( unsigned iReader = 0U; iReader < readerCount; ++iReader )
+        {
+            readers.emplace_back( [&, iReader]
+            {
+                uint64_t count = 0U;
+                Pose pose;
+                while ( isRunning.load( std::memory_order_relaxed ) )
+                {
+                    cache.read( pose );
+                    doNotOptimize( pose );
+                    ++count;
+                }
+                readCounts[iReader] = count;
+            } );
+        }
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        Pose pose = {};
+        uint64_t publishCount = 0U;
+        double seconds = 0.0;
+        do
+        {
+            for ( uint32_t iMessage = 0U; iMessage < 1024U; ++iMessage )
+            {
+                pose.timestamp = ++publishCount;
+                source.publish( pose );
+            }
+            seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+        } while ( seconds < runner.minSeconds() );
+
+        isRunning = false;
+        for ( std::thread& reader : readers )
+            reader.join();
+        const double totalSeconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+        uint64_t readCount = 0U;
+        for ( unsigned iReader = 0U; iReader < readerCount; ++iReader )
+            readCount += readCounts[iReader];
+
+        const std::string params = "readers=" + std::to_string(readerCount);
+        runner.add( Result{ "lastvalue.contended_publish", params, publishCount, seconds, 1U, sizeof(Pose) } );
+        if ( readerCount != 0U )
+            runner.add( Result{ "lastvalue.contended_read", params, readCount, totalSeconds, 1U, sizeof(Pose) } );
+    }
+
+    void lastValue( Runner& runner )
+    {
+        if ( !runner.selected( "lastvalue." ) )
+            return;
+
+        {
+            sub0::Publish<Pose> source;
+            sub0::LastValue<Pose> cache;
+            runner.measure( "lastvalue.publish", "readers=0", cMessageCount, cMessageCount * sizeof(Pose), [&]
+            {
+                Pose pose = {};
+                for ( uint32_t iMessage = 0U; iMessage < cMessageCount; ++iMessage )
+                {
+                    pose.timestamp = iMessage;
+                    source.publish( pose );
+                }
+            } );
+
+            runner.measure( "lastvalue.read", "writers=0", cMessageCount, cMessageCount * sizeof(Pose), [&]
+            {
+                Pose pose;
+                for ( uint32_t iMessage = 0U; iMessage < cMessageCount; ++iMessage )
+                {
+                    cache.read( pose );
+                    doNotOptimize( pose );
+                }
+            } );
+        }
+
+        const unsigned hardwareThreads = std::max( std::thread::hardware_concurrency(), 2U );
+        for ( unsigned readerCount = 1U; readerCount < hardwareThreads; readerCount *= 2U )
+            contended( runner, readerCount );
+    }
+
+} // END: anonymous
+
+SUB0_BENCHMARK( lastValue );
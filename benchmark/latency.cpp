@@ -0,0 +1,381 @@
+/** Ping-pong round-trip latency of each transport
+ * @remark A Ping is published and an echo replies with a Pong, each round-trip is recorded into a Histogram after a
+ *  warm-up. Transports are the inline broker, and a StreamSerializer/StreamDeserializer pair over a pipe, Unix domain
+ *  socket and TCP loopback. Stream transports echo from a forked process pinned to a different core where available,
+ *  as brokers are process-wide a Ping published in-process would loop back into the serialiser.
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#include "benchmark.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SUB0PUB_BENCHMARK_POSIX true
+#include <arpa/inet.h> //< htonl
+#include <netinet/in.h> //< sockaddr_in
+#include <netinet/tcp.h> //< TCP_NODELAY
+#include <poll.h> //< poll
+#include <sys/socket.h> //< socketpair
+#include <sys/wait.h> //< waitpid
+#include <unistd.h> //< fork, pipe
+#else
+#define SUB0PUB_BENCHMARK_POSIX false
+#endif
+
+#if defined(__linux__)
+#include <sched.h> //< sched_setaffinity
+#include <thread> //< std::thread::hardware_concurrency
+#endif
+
+namespace
+{
+    using namespace sub0::benchmark;
+
+    template< uint32_t cTag >
+    struct Message
+    {
+        uint64_t sequence;
+        uint8_t payload[56];
+    };
+
+    typedef Message<0U> Ping;
+    typedef Message<1U> Pong;
+
+    const uint64_t cWarmupCount = 10000U; ///< Round-trips discarded before measuring
+    const uint64_t cMinSampleCount = 10000U; ///< Round-trips measured at least
+
+    uint64_t now()
+    { return sub0::utility::Clock::now(); }
+
+    /** Pin the calling thread or process to a core, modulo the available cores
+    */
+    void pinToCore( const uint32_t core )
+    {
+#if defined(__linux__)
+        cpu_set_t cores;
+        CPU_ZERO( &cores );
+        CPU_SET( core % std::max( std::thread::hardware_concurrency(), 1U ), &cores );
+        sched_setaffinity( 0, sizeof(cores), &cores );
+#else
+        (void)core; ///< @todo Affinity on other platforms
+#endif
+    }
+
+    /** Bounce Ping until the minimum duration and sample count have been reached
+     * @param roundTrip  Callable publishing a Ping and returning once the Pong is received, false if the echo failed
+     */
+    template< typename RoundTrip >
+    void measure( Runner& runner, const std::string& params, RoundTrip&& roundTrip )
+    {
+        Ping ping = {};
+        for ( uint64_t iWarmup = 0U; iWarmup < cWarmupCount; ++iWarmup, ++ping.sequence )
+        {
+            if ( !roundTrip( ping ) )
+                return;
+        }
+
+        Histogram histogram;
+        const uint64_t start = now();
+        uint64_t end = start;
+        while ( (histogram.count() < cMinSampleCount) || (double(end - start) < runner.minSeconds() * 1e9) )
+        {
+            const uint64_t sent = now();
+            if ( !roundTrip( ping ) )
+                return;
+            end = now();
+            histogram.record( end - sent );
+            ++ping.sequence;
+        }
+
+        Result result = { "latency.ping_pong", params, histogram.count(), double(end - start) * 1e-9, 1U, 2U * sizeof(Ping) };
+        result.latency = histogram.percentiles();
+        runner.add( result );
+    }
+
+    /** Replies to Ping with Pong of the same sequence
+    */
+    class Echo : public sub0::Subscribe<Ping>
+               , public sub0::Publish<Pong>
+    {
+    public:
+        void receive( const Ping& ping ) override
+        {
+            Pong pong = {};
+            pong.sequence = ping.sequence;
+            sub0::Publish<Pong>::publish( pong );
+        }
+    };
+
+    /** Records sequence of the last Pong received
+    */
+    class Pinger : public sub0::Subscribe<Pong>
+    {
+    public:
+        void receive( const Pong& pong ) override
+        { sequence_ = pong.sequence; }
+
+        uint64_t sequence_ = 0U;
+    };
+
+    void inlineBroker( Runner& runner )
+    {
+        Echo echo;
+        Pinger pinger;
+        sub0::Publish<Ping> source;
+        measure( runner, "transport=inline", [&]( const Ping& ping )
+        {
+            source.publish( ping );
+            return pinger.sequence_ == ping.sequence;
+        } );
+    }
+
+#if SUB0PUB_BENCHMARK_POSIX
+    /** ByteSink writing whole frames to a file descriptor on flush()
+    */
+    class FdSink
+    {
+    public:
+        explicit FdSink( const int fd )
+            : fd_(fd), size_(0U)
+        {}
+
+        size_t write( const char* const buffer, const size_t bufferCount )
+        {
+            const size_t count = std::min( bufferCount, sizeof(buffer_) - size_ );
+            std::memcpy( buffer_ + size_, buffer, count );
+            size_ += count;
+            return count;
+        }
+
+        void flush()
+        {
+            for ( size_t written = 0U; written < size_; )
+            {
+                const ssize_t count = ::write( fd_, buffer_ + written, size_ - written );
+                if ( count <= 0 )
+                    break;
+                written += static_cast<size_t>( count );
+            }
+            size_ = 0U;
+        }
+
+    private:
+        int fd_;
+        char buffer_[256];
+        size_t size_;
+    };
+
+    /** Buffered ByteSource reading from a file descriptor without blocking
+     * @remark BinaryReader::update() continues into the next frame after publishing, so read() returns what is
+     *  available and wait() blocks until more arrives
+     */
+    class FdSource
+    {
+    public:
+        explicit FdSource( const int fd )
+            : fd_(fd), begin_(0U), end_(0U), isEof_(false)
+        {}
+
+        size_t read( char* const buffer, const size_t bufferCount )
+        {
+            if ( (begin_ == end_) && !fill( 0 ) )
+                return 0U;
+            const size_t count = std::min( bufferCount, end_ - begin_ );
+            std::memcpy( buffer, buffer_ + begin_, count );
+            begin_ += count;
+            return count;
+        }
+
+        /** Block until bytes are available to read()
+         * @return False at end of stream
+         */
+        bool wait()
+        { return (begin_ != end_) || fill( -1 ); }
+
+        bool isEof() const
+        { return isEof_; }
+
+    private:
+        /** Read available bytes into the empty buffer, waiting up to 'timeoutMs' for them
+        */
+        bool fill( const int timeoutMs )
+        {
+            pollfd readable = { fd_, POLLIN, 0 };
+            if ( isEof_ || (poll( &readable, 1, timeoutMs ) <= 0) )
+                return false;
+
+            const ssize_t count = ::read( fd_, buffer_, sizeof(buffer_) );
+            isEof_ = (count <= 0);
+            begin_ = 0U;
+            end_ = isEof_ ? 0U : static_cast<size_t>( count );
+            return !isEof_;
+        }
+
+    private:
+        int fd_;
+        char buffer_[4096];
+        size_t begin_; ///< Position of the next byte to read() in buffer_
+        size_t end_; ///< End of bytes read into buffer_
+        bool isEof_;
+    };
+
+    template< typename Data >
+    class Recorder : public sub0::StreamSerializer< sub0::DefaultSerialisation, sub0::DefaultSerialisation::Writer, FdSink >
+                   , public sub0::ForwardSubscribe< Data, Recorder<Data> >
+    {
+    public:
+        Recorder( FdSink& stream )
+            : sub0::StreamSerializer< sub0::DefaultSerialisation, sub0::DefaultSerialisation::Writer, FdSink >( stream )
+        {}
+    };
+
+    template< typename Data >
+    class Decoder : public sub0::StreamDeserializer< sub0::DefaultSerialisation, sub0::DefaultSerialisation::Reader, FdSource >
+                  , public sub0::ForwardPublish< Data, Decoder<Data> >
+    {
+    public:
+        Decoder( FdSource& stream )
+            : sub0::StreamDeserializer< sub0::DefaultSerialisation, sub0::DefaultSerialisation::Reader, FdSource >( stream )
+        {}
+    };
+
+    /** Echo Ping read from 'inFd' as Pong written to 'outFd' until end of stream
+    */
+    void echoStream( const int inFd, const int outFd )
+    {
+        FdSource source( inFd );
+        FdSink sink( outFd );
+        Decoder<Ping> decoder( source );
+        Recorder<Pong> recorder( sink );
+        Echo echo;
+        decoder.open();
+        recorder.open();
+        while ( source.wait() )
+        {
+            decoder.update();
+            sink.flush();
+        }
+    }
+
+    /** Measure round-trips over a connected pair of streams with the echo in a forked process
+     * @param pingFds  Read and write descriptors carrying Ping, both closed on return
+     * @param pongFds  Read and write descriptors carrying Pong, both closed on return
+     */
+    void pingPongStream( Runner& runner, const std::string& params, const int pingFds[2], const int pongFds[2] )
+    {
+        const pid_t child = fork();
+        if ( child == 0 )
+        {
+            pinToCore( 1U );
+            ::close( pingFds[1] );
+            ::close( pongFds[0] );
+            echoStream( pingFds[0], pongFds[1] );
+            _exit( 0 );
+        }
+        ::close( pingFds[0] );
+        ::close( pongFds[1] );
+
+        if ( child > 0 )
+        {
+            FdSink sink( pingFds[1] );
+            FdSource source( pongFds[0] );
+            Recorder<Ping> recorder( sink );
+            Decoder<Pong> decoder( source );
+            Pinger pinger;
+            sub0::Publish<Ping> publisher;
+            recorder.open();
+            decoder.open();
+            measure( runner, params, [&]( const Ping& ping )
+            {
+                publisher.publish( ping );
+                sink.flush();
+                while ( pinger.sequence_ != ping.sequence )
+                {
+                    if ( !source.wait() )
+                        return false;
+                    decoder.update();
+                }
+                return true;
+            } );
+        }
+
+        ::close( pingFds[1] ); //< End of stream stops the echo
+        ::close( pongFds[0] );
+        if ( child > 0 )
+            waitpid( child, nullptr, 0 );
+    }
+
+    void pipes( Runner& runner )
+    {
+        int pingFds[2], pongFds[2];
+        if ( (pipe( pingFds ) == 0) && (pipe( pongFds ) == 0) )
+            pingPongStream( runner, "transport=pipe", pingFds, pongFds );
+    }
+
+    void unixSocket( Runner& runner )
+    {
+        int fds[2];
+        if ( socketpair( AF_UNIX, SOCK_STREAM, 0, fds ) != 0 )
+            return;
+        const int pingFds[2] = { fds[1], fds[0] };
+        const int pongFds[2] = { dup( fds[0] ), dup( fds[1] ) }; //< Each end closed separately
+        pingPongStream( runner, "transport=uds", pingFds, pongFds );
+    }
+
+    void tcpLoopback( Runner& runner )
+    {
+        const int listener = socket( AF_INET, SOCK_STREAM, 0 );
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+        address.sin_port = 0U; //< Any free port
+        socklen_t addressSize = sizeof(address);
+        if ( (listener < 0)
+          || (bind( listener, reinterpret_cast<sockaddr*>(&address), sizeof(address) ) != 0)
+          || (listen( listener, 1 ) != 0)
+          || (getsockname( listener, reinterpret_cast<sockaddr*>(&address), &addressSize ) != 0) )
+        {
+            if ( listener >= 0 )
+                ::close( listener );
+            return;
+        }
+
+        const int client = socket( AF_INET, SOCK_STREAM, 0 );
+        const bool connected = (client >= 0) && (connect( client, reinterpret_cast<sockaddr*>(&address), sizeof(address) ) == 0);
+        const int server = connected ? accept( listener, nullptr, nullptr ) : -1;
+        ::close( listener );
+        if ( server < 0 )
+        {
+            if ( client >= 0 )
+                ::close( client );
+            return;
+        }
+
+        const int noDelay = 1;
+        setsockopt( client, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay) );
+        setsockopt( server, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay) );
+        const int pingFds[2] = { server, client };
+        const int pongFds[2] = { dup( client ), dup( server ) }; //< Each end closed separately
+        pingPongStream( runner, "transport=tcp", pingFds, pongFds );
+    }
+#endif
+
+    void latency( Runner& runner )
+    {
+        if ( !runner.selected( "latency." ) )
+            return;
+
+        TypeName<Ping> pingName( 0x800, "Ping" );
+        TypeName<Pong> pongName( 0x801, "Pong" );
+
+        pinToCore( 0U );
+        inlineBroker( runner );
+#if SUB0PUB_BENCHMARK_POSIX
+        pipes( runner );
+        unixSocket( runner );
+        tcpLoopback( runner );
+#endif
+    }
+
+} // END: anonymous
+
+SUB0_BENCHMARK( latency );
@@ -0,0 +1,118 @@
+/** Sub0Pub benchmark runner
+ * @remark usage: Sub0Pub_Benchmarks [--filter=<substring>] [--min-time=<seconds>] [--out=<file.json>]
+ *         Results are written as JSON to stdout, or to the --out file, progress is reported to stderr
+ *         Exits with failure if a verifying benchmark failed e.g. allocation.* made a heap allocation
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#include "benchmark.hpp"
+
+#include <cstdio> //< std::fprintf
+#include <cstdlib> //< std::atof
+
+namespace sub0
+{
+    namespace benchmark
+    {
+        std::vector<BenchmarkFunction>& registry()
+        {
+            static std::vector<BenchmarkFunction> functions;
+            return functions;
+        }
+
+        void Runner::report( const Result& result )
+        {
+            if ( result.latency.max != 0U )
+            {
+                std::fprintf( stderr, "%-40s %-32s p50 %8llu ns  p90 %8llu ns  p99 %8llu ns  p99.9 %8llu ns  max %10llu ns\n"
+                    , result.name.c_str(), result.params.c_str()
+                    , static_cast<unsigned long long>(result.latency.p50), static_cast<unsigned long long>(result.latency.p90)
+                    , static_cast<unsigned long long>(result.latency.p99), static_cast<unsigned long long>(result.latency.p999)
+                    , static_cast<unsigned long long>(result.latency.max) );
+                return;
+            }
+
+            std::fprintf( stderr, "%-40s %-32s %12.1f ns/op %14.0f msgs/s %10.1f MB/s\n"
+                , result.name.c_str(), result.params.c_str()
+                , result.nsPerIteration(), result.itemsPerSecond(), result.bytesPerSecond() / 1e6 );
+        }
+
+        void Runner::fail( const std::string& name, const std::string& params, const std::string& reason )
+        {
+            ++failureCount_;
+            std::fprintf( stderr, "%-40s %-32s FAILED: %s\n", name.c_str(), params.c_str(), reason.c_str() );
+        }
+
+        /** Write results as JSON document
+        */
+        static void writeJson( std::FILE* file, const std::vector<Result>& results )
+        {
+            std::fprintf( file, "{\n  \"benchmarks\": [" );
+            for ( size_t iResult = 0U; iResult < results.size(); ++iResult )
+            {
+                const Result& result = results[iResult];
+                std::fprintf( file, "%s\n    {\"name\": \"%s\", \"params\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f"
+                                    ", \"items_per_second\": %.1f, \"bytes_per_second\": %.1f"
+                    , iResult ? "," : ""
+                    , result.name.c_str(), result.params.c_str()
+                    , static_cast<unsigned long long>(result.iterations), result.nsPerIteration()
+                    , result.itemsPerSecond(), result.bytesPerSecond() );
+                if ( result.latency.max != 0U )
+                {
+                    std::fprintf( file, ", \"latency_ns\": {\"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"p99.9\": %llu, \"max\": %llu}}"
+                        , static_cast<unsigned long long>(result.latency.p50), static_cast<unsigned long long>(result.latency.p90)
+                        , static_cast<unsigned long long>(result.latency.p99), static_cast<unsigned long long>(result.latency.p999)
+                        , static_cast<unsigned long long>(result.latency.max) );
+                }
+                else
+                    std::fprintf( file, "}" );
+            }
+            std::fprintf( file, "\n  ]\n}\n" );
+        }
+
+    } // END: benchmark
+} // END: sub0
+
+int main( int argc, char* argv[] )
+{
+    std::string filter;
+    double minSeconds = 0.2;
+    const char* outPath = nullptr;
+
+    for ( int iArg = 1; iArg < argc; ++iArg )
+    {
+        const std::string arg = argv[iArg];
+        if ( arg.compare( 0, 9, "--filter=" ) == 0 )
+            filter = arg.substr( 9 );
+        else if ( arg.compare( 0, 11, "--min-time=" ) == 0 )
+            minSeconds = std::atof( arg.c_str() + 11 );
+        else if ( arg.compare( 0, 6, "--out=" ) == 0 )
+            outPath = argv[iArg] + 6;
+        else
+        {
+            std::fprintf( stderr, "usage: %s [--filter=<substring>] [--min-time=<seconds>] [--out=<file.json>]\n", argv[0] );
+            return 1;
+        }
+    }
+
+    sub0::benchmark::Runner runner( filter, minSeconds );
+    for ( sub0::benchmark::BenchmarkFunction function : sub0::benchmark::registry() )
+        function( runner );
+
+    std::FILE* file = outPath ? std::fopen( outPath, "w" ) : stdout;
+    if ( file == nullptr )
+    {
+        std::fprintf( stderr, "Failed to open '%s'\n", outPath );
+        return 1;
+    }
+    sub0::benchmark::writeJson( file, runner.results() );
+    if ( file != stdout )
+        std::fclose( file );
+
+    if ( runner.failureCount() != 0U )
+    {
+        std::fprintf( stderr, "%zu benchmark verifications failed\n", runner.failureCount() );
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+/** Benchmark of k-way timestamp merge of multiple recordings
+ * @remark Inputs are interleaved frame-by-frame which is the worst case for the merge i.e. Every frame changes input
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#include "benchmark.hpp"
+
+#include "sub0pub/merge.hpp"
+
+namespace
+{
+    using namespace sub0::benchmark;
+
+    struct Sample
+    {
+        uint64_t timestamp;
+        uint8_t payload[24];
+    };
+
+    const uint32_t cMessageCount = 256U * 1024U; ///< Frames across all inputs
+
+    class Recorder : public sub0::StreamSerializer<>
+                   , public sub0::ForwardSubscribe< Sample, Recorder >
+    {
+    public:
+        Recorder( MemoryOStream& stream )
+            : sub0::StreamSerializer<>( stream )
+        {}
+    };
+
+    class Merger : public sub0::MergeDeserializer<>
+                 , public sub0::ForwardPublish< Sample, Merger >
+    {};
+
+    /** Counts samples and verifies global order
+    */
+    class Ordered : public sub0::Subscribe<Sample>
+    {
+    public:
+        void receive( const Sample& sample ) override
+        {
+            inOrder_ &= (sample.timestamp >= last_);
+            last_ = sample.timestamp;
+            ++count_;
+        }
+
+        uint64_t last_ = 0U;
+        uint64_t count_ = 0U;
+        bool inOrder_ = true;
+    };
+
+    void merge( Runner& runner )
+    {
+        if ( !runner.selected( "merge." ) )
+            return;
+
+        TypeName<Sample> name( 0x210, "Sample" );
+
+        for ( uint32_t inputCount = 2U; inputCount <= 64U; inputCount *= 2U )
+        {
+            std::vector<MemoryOStream> recordings( inputCount );
+            for ( uint32_t iInput = 0U; iInput < inputCount; ++iInput )
+            {
+                Recorder recorder( recordings[iInput] );
+                sub0::Publish<Sample> source;
+                for ( uint32_t iMessage = iInput; iMessage < cMessageCount; iMessage += inputCount )
+                    source.publish( Sample{ iMessage, {} } );
+            }
+
+            std::vector<MemoryIStream> streams;
+            Merger merger;
+            for ( const MemoryOStream& recording : recordings )
+                streams.emplace_back( recording.bytes.data(), recording.bytes.size() );
+            for ( MemoryIStream& stream : streams )
+                merger.addInput( stream );
+
+            Ordered ordered;
+            runner.measure( "merge.timestamp", "inputs=" + std::to_string(inputCount), cMessageCount, cMessageCount * sizeof(Sample), [&]
+            {
+                for ( MemoryIStream& stream : streams )
+                    stream.rewind();
+                ordered.last_ = 0U;
+                merger.open();
+                while ( merger.update() ) {}
+            } );
+
+            if ( !ordered.inOrder_ )
+                std::fprintf( stderr, "merge.timestamp inputs=%u published out of order\n", inputCount );
+        }
+    }
+
+} // END: anonymous
+
+SUB0_BENCHMARK( merge );
@@ -0,0 +1,159 @@
+/** Benchmark of parallel decoding of a segmented recording
+ * @remark Compares single-threaded StreamDeserializer against ParallelDeserializer for increasing worker counts
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#include "benchmark.hpp"
+
+#include "sub0pub/parallel.hpp"
+
+#include <thread> //< std::thread::hardware_concurrency
+
+namespace
+{
+    using namespace sub0::benchmark;
+
+    template< uint32_t cTag >
+    using Message = Payload<64U, cTag>;
+
+    typedef std::tuple< Message<0>, Message<1>, Message<2>, Message<3>
+                      , Message<4>, Message<5>, Message<6>, Message<7> > Messages;
+
+    const uint32_t cMessageCount = 256U * 1024U; ///< Frames in the recording
+    const size_t cSegmentBytes = 256U * 1024U; ///< Segment size of the split recording
+
+    /** Subscriber performing a representative amount of work per message
+    */
+    template< typename Data >
+    class Checksum : public sub0::Subscribe<Data>
+    {
+    public:
+        void receive( const Data& data ) override
+        {
+            uint32_t sum = sum_;
+            for ( const uint8_t byte : data.bytes )
+                sum = sum * 31U + byte;
+            sum_ = sum;
+        }
+
+        uint32_t sum_ = 0U;
+    };
+
+    template< typename... Datas >
+    class PublishAll : public sub0::Publish<Datas>... {};
+
+    template< typename... Datas >
+    class PublishAll< std::tuple<Datas...> > : public sub0::Publish<Datas>... {};
+
+    template< typename... Datas >
+    class ChecksumAll : public Checksum<Datas>... {};
+
+    template< typename... Datas >
+    class ChecksumAll< std::tuple<Datas...> > : public Checksum<Datas>... {};
+
+    class Recorder : public sub0::StreamSerializer<>
+                   , public sub0::ForwardSubscribeAll< Recorder, Messages >
+    {
+    public:
+        Recorder( MemoryOStream& stream )
+            : sub0::StreamSerializer<>( stream )
+        {}
+    };
+
+    class StreamDecoder : public sub0::StreamDeserializer<>
+                        , public sub0::ForwardPublishAll< StreamDecoder, Messages >
+    {
+    public:
+        StreamDecoder( MemoryIStream& stream )
+            : sub0::StreamDeserializer<>( stream )
+        {}
+    };
+
+    class ParallelDecoder : public sub0::ParallelDeserializer<>
+                          , public sub0::ForwardPublishAll< ParallelDecoder, Messages >
+    {
+    public:
+        ParallelDecoder( const std::vector<char>& recording )
+            : sub0::ParallelDeserializer<>( recording.data(), recording.size() )
+        {}
+    };
+
+    /** Publish cMessageCount messages round-robin across the Messages types
+    */
+    template< size_t... iTypes >
+    void record( PublishAll<Messages>& source, std::index_sequence<iTypes...> )
+    {
+        for ( uint32_t iMessage = 0U; iMessage < cMessageCount; iMessage += sizeof...(iTypes) )
+        {
+            int expand[] = { ( [&]{
+                Message<iTypes> message;
+                std::memset( message.bytes, static_cast<int>(iMessage + iTypes), sizeof(message.bytes) );
+                sub0::publish( source, message );
+            }(), 0 )... };
+            (void)expand;
+        }
+    }
+
+    void parallelDecode( Runner& runner )
+    {
+        if ( !runner.selected( "parallel." ) )
+            return;
+
+        TypeName< Message<0> > name0( 0x100, "Message0" );
+        TypeName< Message<1> > name1( 0x101, "Message1" );
+        TypeName< Message<2> > name2( 0x102, "Message2" );
+        TypeName< Message<3> > name3( 0x103, "Message3" );
+        TypeName< Message<4> > name4( 0x104, "Message4" );
+        TypeName< Message<5> > name5( 0x105, "Message5" );
+        TypeName< Message<6> > name6( 0x106, "Message6" );
+        TypeName< Message<7> > name7( 0x107, "Message7" );
+
+        MemoryOStream recording;
+        {
+            Recorder recorder( recording );
+            PublishAll<Messages> source;
+            record( source, std::make_index_sequence< std::tuple_size<Messages>::value >() );
+        }
+
+        ChecksumAll<Messages> subscribers;
+
+        {
+            MemoryIStream stream( recording.bytes.data(), recording.bytes.size() );
+            StreamDecoder decoder( stream );
+            runner.measure( "parallel.stream_deserializer", "workers=1", cMessageCount, recording.bytes.size(), [&]
+            {
+                stream.rewind();
+                decoder.open();
+                while ( decoder.update() ) {}
+            } );
+        }
+
+        const unsigned hardwareThreads = std::max( std::thread::hardware_concurrency(), 1U );
+        for ( const bool ordered : { true, false } )
+        {
+            for ( unsigned workerCount = 1U; ; workerCount = std::min( workerCount * 2U, hardwareThreads ) )
+            {
+                ParallelDecoder decoder( recording.bytes );
+                sub0::ParallelDeserializer<>::Config config;
+                config.workerCount = static_cast<uint_fast16_t>( workerCount );
+                config.segmentBytes = cSegmentBytes;
+                config.delivery = ordered ? sub0::ParallelDeserializer<>::Delivery::Ordered
+                                          : sub0::ParallelDeserializer<>::Delivery::UnorderedPerType;
+                decoder.configure( config );
+                decoder.open();
+
+                runner.measure( ordered ? "parallel.ordered" : "parallel.unordered_per_type"
+                              , "workers=" + std::to_string(workerCount), cMessageCount, recording.bytes.size(), [&]
+                {
+                    decoder.update();
+                } );
+
+                if ( workerCount == hardwareThreads )
+                    break;
+            }
+        }
+    }
+
+} // END: anonymous
+
+SUB0_BENCHMARK( parallelDecode );
@@ -0,0 +1,141 @@
+/** Benchmark of a fused operator pipeline against the equivalent chain of adapter subscribers
+ * @remark Filter, map and moving average of a raw sample, the adapters republish an intermediate topic at each hop
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#include "benchmark.hpp"
+
+#include "sub0pub/pipeline.hpp"
+
+namespace
+{
+    using namespace sub0::benchmark;
+
+    struct Raw
+    {
+        uint64_t timestamp;
+        int32_t value;
+        uint32_t flags;
+    };
+
+    struct Scaled
+    {
+        float value;
+    };
+
+    struct Filtered
+    {
+        Raw raw;
+    };
+
+    struct Cooked
+    {
+        float mean;
+    };
+
+    const uint32_t cMessageCount = 1024U * 1024U; ///< Raw publishes per iteration
+    const size_t cWindow = 8U; ///< Samples averaged
+
+    bool isValid( const Raw& raw )
+    { return (raw.flags & 1U) == 0U; }
+
+    Scaled scale( const Raw& raw )
+    { return Scaled{ float(raw.value) * 0.5f }; }
+
+    float mean( const Scaled* const values, const size_t count )
+    {
+        float sum = 0.0f;
+        for ( size_t iValue = 0U; iValue < count; ++iValue )
+            sum += values[iValue].value;
+        return sum / float(count);
+    }
+
+    /** Hop 1: republish valid samples
+    */
+    class FilterAdapter : public sub0::Subscribe<Raw>
+                        , public sub0::Publish<Filtered>
+    {
+    public:
+        void receive( const Raw& raw ) override
+        {
+            if ( isValid( raw ) )
+                publish( Filtered{ raw } );
+        }
+    };
+
+    /** Hop 2: republish scaled samples
+    */
+    class MapAdapter : public sub0::Subscribe<Filtered>
+                     , public sub0::Publish<Scaled>
+    {
+    public:
+        void receive( const Filtered& filtered ) override
+        { publish( scale( filtered.raw ) ); }
+    };
+
+    /** Hop 3: publish the moving average
+    */
+    class WindowAdapter : public sub0::Subscribe<Scaled>
+                        , public sub0::Publish<Cooked>
+    {
+    public:
+        void receive( const Scaled& scaled ) override
+        {
+            values_[position_] = values_[position_ + cWindow] = scaled;
+            position_ = (position_ + 1U) % cWindow;
+            if ( count_ < cWindow && ++count_ < cWindow )
+                return;
+            publish( Cooked{ mean( values_ + position_, cWindow ) } );
+        }
+
+    private:
+        Scaled values_[2U * cWindow] = {};
+        size_t position_ = 0U;
+        size_t count_ = 0U;
+    };
+
+    class Sink : public sub0::Subscribe<Cooked>
+    {
+    public:
+        void receive( const Cooked& cooked ) override
+        { sum_ += cooked.mean; }
+
+        float sum_ = 0.0f;
+    };
+
+    void pipeline( Runner& runner )
+    {
+        if ( !runner.selected( "pipeline." ) )
+            return;
+
+        sub0::Publish<Raw> source;
+        Sink sink;
+        const auto publish = [&]
+        {
+            Raw raw = {};
+            for ( uint32_t iMessage = 0U; iMessage < cMessageCount; ++iMessage )
+            {
+                raw.value = static_cast<int32_t>( iMessage );
+                raw.flags = iMessage & 3U; //< Half are invalid
+                source.publish( raw );
+            }
+        };
+
+        {
+            FilterAdapter filterAdapter;
+            MapAdapter mapAdapter;
+            WindowAdapter windowAdapter;
+            runner.measure( "pipeline.publish", "stages=adapters", cMessageCount, cMessageCount * sizeof(Raw), publish );
+        }
+        {
+            using namespace sub0::pipeline;
+            auto fused = from<Raw>() | filter( &isValid ) | map( &scale ) | window<cWindow>( &mean )
+                       | map( []( const float value ) { return Cooked{ value }; } ) | to<Cooked>();
+            runner.measure( "pipeline.publish", "stages=fused", cMessageCount, cMessageCount * sizeof(Raw), publish );
+        }
+        doNotOptimize( sink.sum_ );
+    }
+
+} // END: anonymous
+
+SUB0_BENCHMARK( pipeline );
@@ -0,0 +1,223 @@
+/** Benchmark of endian-portable serialisation
+ * @remark Compares the raw memcpy path of DefaultSerialisation against PortableSerialisation in host and foreign byte
+ *  order, and the packed layout of a type with padding. Bytes per second are of the serialised stream. Before timing
+ *  the frame size and the payload of the first frame are compared with each field encoded in the wire byte order and
+ *  layout, and each decoded message is compared field-by-field with the published message.
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#include "benchmark.hpp"
+
+#include "sub0pub/portable.hpp"
+
+#include <cstring> //< std::memcmp
+#include <string> //< std::to_string
+
+namespace bench
+{
+    /** Mixed scalar message with nested and array fields
+    */
+    struct Pose
+    {
+        uint64_t timestamp;
+        uint32_t sequence;
+        uint16_t status;
+        uint16_t mode;
+        double position[3];
+        float orientation[4];
+        float covariance[16];
+    };
+
+    /** Mixed byte and double fields where padding is a large fraction of sizeof()
+    */
+    struct Status
+    {
+        uint8_t source;
+        double voltage;
+        uint8_t state;
+        double current;
+        uint8_t flags;
+        uint16_t faults;
+        double temperature;
+    };
+}
+
+SUB0_FIELDS( bench::Pose, &bench::Pose::timestamp, &bench::Pose::sequence, &bench::Pose::status, &bench::Pose::mode
+           , &bench::Pose::position, &bench::Pose::orientation, &bench::Pose::covariance )
+SUB0_FIELDS( bench::Status, &bench::Status::source, &bench::Status::voltage, &bench::Status::state, &bench::Status::current
+           , &bench::Status::flags, &bench::Status::faults, &bench::Status::temperature )
+
+namespace
+{
+    using namespace sub0::benchmark;
+    using bench::Pose;
+    using bench::Status;
+
+    const uint32_t cMessageCount = 64U * 1024U; ///< Messages per iteration
+
+    const sub0::Endian cForeign = (sub0::Endian::Native == sub0::Endian::Little) ? sub0::Endian::Big : sub0::Endian::Little;
+
+    template< typename Protocol, typename Data >
+    class Recorder : public sub0::StreamSerializer<Protocol>
+                   , public sub0::ForwardSubscribe< Data, Recorder<Protocol, Data> >
+    {
+    public:
+        Recorder( MemoryOStream& stream )
+            : sub0::StreamSerializer<Protocol>( stream )
+        {}
+    };
+
+    template< typename Protocol, typename Data >
+    class Decoder : public sub0::StreamDeserializer<Protocol>
+                  , public sub0::ForwardPublish< Data, Decoder<Protocol, Data> >
+    {
+    public:
+        Decoder( MemoryIStream& stream )
+            : sub0::StreamDeserializer<Protocol>( stream )
+        {}
+    };
+
+    template< typename Data >
+    class Sink : public sub0::Subscribe<Data>
+    {
+    public:
+        void receive( const Data& data ) override
+        { doNotOptimize( data ); }
+    };
+
+    /** Compares each SUB0_FIELDS member of received messages with the published message, padding is ignored
+    */
+    template< typename Data >
+    class Checker : public sub0::Subscribe<Data>
+    {
+    public:
+        explicit Checker( const Data& expected )
+            : expected_(expected)
+        {}
+
+        void receive( const Data& data ) override
+        {
+            std::apply( [&]( auto... members )
+            {
+                ( (wrongFieldCount_ += (std::memcmp( &(data.*members), &(expected_.*members), sizeof(data.*members) ) != 0) ? 1U : 0U), ... );
+            }, sub0::Fields<Data>::members() );
+            ++receivedCount_;
+        }
+
+        const Data& expected_;
+        uint64_t receivedCount_ = 0U;
+        uint64_t wrongFieldCount_ = 0U; ///< Sum over messages of the fields differing from expected_
+    };
+
+    /** @return Count of bytes of the SUB0_FIELDS members of 'data' differing from their encoding in 'payload'
+     * @param payload  Payload of a frame
+     * @param wire  Byte order of scalars in 'payload'
+     * @param layout  Fields of 'payload' are consecutive for Layout::Packed, otherwise at their offset within Data
+     */
+    template< typename Data >
+    size_t wrongWireBytes( const char* const payload, const Data& data, const sub0::Endian wire, const sub0::Layout layout )
+    {
+        size_t wrongCount = 0U;
+        size_t packedOffset = 0U;
+        const auto checkField = [&]( const auto& field )
+        {
+            typedef typename std::remove_all_extents< typename std::remove_reference<decltype(field)>::type >::type Scalar_t;
+            const char* const fieldBytes = reinterpret_cast<const char*>( &field );
+            const size_t offset = (layout == sub0::Layout::Packed) ? packedOffset : static_cast<size_t>( fieldBytes - reinterpret_cast<const char*>( &data ) );
+            packedOffset += sizeof(field);
+            for ( size_t iByte = 0U; iByte < sizeof(field); ++iByte )
+            {
+                const size_t iScalarByte = iByte % sizeof(Scalar_t);
+                const size_t iSource = (wire == sub0::Endian::Native) ? iByte : iByte - iScalarByte + (sizeof(Scalar_t) - 1U - iScalarByte);
+                wrongCount += (payload[offset + iByte] == fieldBytes[iSource]) ? 0U : 1U;
+            }
+        };
+        std::apply( [&]( auto... members ) { ( checkField( data.*members ), ... ); }, sub0::Fields<Data>::members() );
+        return wrongCount;
+    }
+
+    template< typename Protocol, typename Data >
+    void measure( Runner& runner, const std::string& name, const char* const params, const Data& message
+                , const sub0::Endian wire, const sub0::Layout layout = sub0::Layout::Native )
+    {
+        sub0::Publish<Data> source;
+
+        MemoryOStream recording;
+        recording.bytes.reserve( cMessageCount * (sizeof(Data) + 32U) );
+        const auto record = [&]
+        {
+            recording.bytes.clear();
+            for ( uint32_t iMessage = 0U; iMessage < cMessageCount; ++iMessage )
+                source.publish( message );
+        };
+
+        {
+            Recorder<Protocol, Data> recorder( recording );
+            record();
+
+            const size_t payloadOffset = sizeof(typename Protocol::Prefix) + sizeof(typename Protocol::Header);
+            const size_t payloadBytes = (layout == sub0::Layout::Packed) ? sub0::portable::wireSize<Data>() : sizeof(Data);
+            const size_t frameBytes = payloadOffset + payloadBytes + sizeof(typename Protocol::Postfix);
+            if ( recording.bytes.size() != cMessageCount * frameBytes )
+            {
+                runner.fail( name + ".write", params, std::to_string( recording.bytes.size() ) + " bytes recorded of "
+                    + std::to_string( cMessageCount * frameBytes ) + " for " + std::to_string( payloadBytes ) + " byte payloads" );
+            }
+
+            const size_t wrongBytes = wrongWireBytes( recording.bytes.data() + payloadOffset, message, wire, layout );
+            if ( wrongBytes != 0U )
+                runner.fail( name + ".write", params, std::to_string( wrongBytes ) + " payload bytes differ from the wire byte order" );
+
+            const size_t recordingBytes = recording.bytes.size();
+            runner.measure( name + ".write", params, cMessageCount, recordingBytes, record );
+        }
+
+        MemoryIStream stream( recording.bytes.data(), recording.bytes.size() );
+        Decoder<Protocol, Data> decoder( stream );
+        const auto read = [&]
+        {
+            stream.rewind();
+            decoder.open();
+            while ( decoder.update() ) {}
+        };
+
+        {
+            Checker<Data> checker( message );
+            read();
+            if ( checker.receivedCount_ != cMessageCount || checker.wrongFieldCount_ != 0U )
+            {
+                runner.fail( name + ".read", params, std::to_string( checker.receivedCount_ ) + " messages of " + std::to_string( cMessageCount )
+                    + ", " + std::to_string( checker.wrongFieldCount_ ) + " fields differ" );
+            }
+        }
+
+        Sink<Data> sink;
+        runner.measure( name + ".read", params, cMessageCount, recording.bytes.size(), read );
+    }
+
+    void portableSerialisation( Runner& runner )
+    {
+        if ( !runner.selected( "portable." ) )
+            return;
+
+        TypeName<Pose> poseName( 0x300, "Pose" );
+        TypeName<Status> statusName( 0x301, "Status" );
+
+        Pose pose = { 0x0102030405060708U, 0x11223344U, 0x5566U, 0x7788U, { 1.5, -2.25, 1e6 + 0.125 }, { 0.125f, -0.5f, 0.25f, 0.75f }, {} };
+        for ( uint32_t iCovariance = 0U; iCovariance < 16U; ++iCovariance )
+            pose.covariance[iCovariance] = 0.1f + float(iCovariance); //< No byte palindromes, a wrong swap of any field is visible
+        measure< sub0::DefaultSerialisation >( runner, "portable.pose", "memcpy", pose, sub0::Endian::Native );
+        measure< sub0::PortableSerialisation<sub0::Endian::Native> >( runner, "portable.pose", "wire=native", pose, sub0::Endian::Native );
+        measure< sub0::PortableSerialisation<cForeign> >( runner, "portable.pose", "wire=foreign", pose, cForeign );
+
+        const Status status = { 0x12U, 24.125, 0x34U, -1.5, 0x80U, 0x1234U, 40.0625 }; //< Every field distinct and non-zero
+        measure< sub0::DefaultSerialisation >( runner, "portable.status", "memcpy", status, sub0::Endian::Native );
+        measure< sub0::PortableSerialisation<sub0::Endian::Native, sub0::Layout::Packed> >( runner, "portable.status", "wire=native layout=packed", status
+                                                                                         , sub0::Endian::Native, sub0::Layout::Packed );
+        measure< sub0::PortableSerialisation<cForeign, sub0::Layout::Packed> >( runner, "portable.status", "wire=foreign layout=packed", status
+                                                                              , cForeign, sub0::Layout::Packed );
+    }
+
+} // END: anonymous
+
+SUB0_BENCHMARK( portableSerialisation );
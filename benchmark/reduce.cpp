@@ -0,0 +1,186 @@
+/** Benchmark of reduction subscribers fed a sample per publish against a batch publish
+ * @remark A float sensor topic reduced by each of Sum, MinMax, MeanVariance, Histogram and Percentile. Results of
+ *  samples fed singly and in batches of varying size are verified against a scalar reference.
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#include "benchmark.hpp"
+
+#include "sub0pub/reduce.hpp"
+
+#include <algorithm> //< std::sort
+#include <cmath> //< std::fabs
+#include <string> //< std::to_string
+#include <vector> //< std::vector
+
+namespace
+{
+    using namespace sub0::benchmark;
+
+    const uint32_t cSampleCount = 1024U * 1024U; ///< Samples per iteration
+    const size_t cBatchSize = 1024U; ///< Samples per batch publish
+    const uint32_t cBinCount = 64U; ///< Histogram bins over the sample range
+    const float cRange = 100.0f; ///< Samples are in [0, cRange)
+
+    /** Statistics of the samples computed one at a time in double
+     */
+    struct Reference
+    {
+        explicit Reference( const std::vector<float>& samples )
+            : sorted( samples )
+            , bins( cBinCount + 2U, 0U )
+        {
+            std::sort( sorted.begin(), sorted.end() );
+            const float scale = static_cast<float>( cBinCount ) / cRange;
+            for ( const float sample : samples )
+            {
+                sum += sample;
+                const float slot = sample * scale + 1.0f; //< As binIndex(), in float
+                ++bins[(slot < static_cast<float>( cBinCount + 1U )) ? static_cast<uint32_t>( slot ) : cBinCount + 1U];
+            }
+            mean = sum / static_cast<double>( samples.size() );
+            for ( const float sample : samples )
+                variance += (sample - mean) * (sample - mean);
+            variance /= static_cast<double>( samples.size() );
+        }
+
+        /** @return Sample at the rank Percentile::quantile() estimates
+         */
+        double quantile( const double fraction ) const
+        { return sorted[static_cast<size_t>( fraction * static_cast<double>( sorted.size() - 1U ) )]; }
+
+        std::vector<float> sorted;
+        std::vector<uint64_t> bins; ///< Underflow, bins, overflow
+        double sum = 0.0;
+        double mean = 0.0;
+        double variance = 0.0;
+    };
+
+    bool isNear( const double value, const double expected, const double relative )
+    { return std::fabs( value - expected ) <= relative * std::max( std::fabs( expected ), 1.0 ); }
+
+    /** Publish 'samples' into the reductions, singly then in batches of varying size so partly filled buffers are
+     *  topped up, flushed and bypassed
+     */
+    void feed( const std::vector<float>& samples )
+    {
+        const sub0::Publish<float> source;
+        size_t iSample = 0U;
+        for ( ; iSample < 1000U; ++iSample )
+            source.publish( samples[iSample] );
+        for ( size_t batchSize = 1U; iSample < samples.size(); batchSize = batchSize % 1500U + 97U )
+        {
+            const size_t count = std::min( batchSize, samples.size() - iSample );
+            source.publish( samples.data() + iSample, count );
+            iSample += count;
+        }
+    }
+
+    void check( Runner& runner, const char* const reductionName, const bool isCorrect, const std::string& reason )
+    {
+        if ( !isCorrect )
+            runner.fail( "reduce.publish", std::string( "reduction=" ) + reductionName, reason );
+    }
+
+    /** Time publish of every sample singly, then in batches, into 'reduction'
+     */
+    template< typename Reduction >
+    void measure( Runner& runner, const char* const reductionName, Reduction& reduction, const std::vector<float>& samples )
+    {
+        const sub0::Publish<float> source;
+        const std::string params = std::string( "reduction=" ) + reductionName;
+        runner.measure( "reduce.publish", params + ",publish=single", cSampleCount, cSampleCount * sizeof(float), [&]
+        {
+            for ( const float sample : samples )
+                source.publish( sample );
+        } );
+        runner.measure( "reduce.publish", params + ",publish=batch", cSampleCount, cSampleCount * sizeof(float), [&]
+        {
+            for ( size_t iSample = 0U; iSample < samples.size(); iSample += cBatchSize )
+                source.publish( samples.data() + iSample, cBatchSize );
+        } );
+        doNotOptimize( reduction.count() );
+    }
+
+    void reduce( Runner& runner )
+    {
+        if ( !runner.selected( "reduce." ) )
+            return;
+
+        std::vector<float> samples( cSampleCount );
+        uint32_t state = 1U;
+        for ( float& sample : samples )
+        {
+            state = state * 1664525U + 1013904223U;
+            sample = static_cast<float>( state >> 8U ) * (100.0f / 16777216.0f); //< [0, 100)
+        }
+
+        const std::vector<float> verified( samples.begin(), samples.end() - 5 ); //< Not a multiple of the vector width so kernel tails run
+        const Reference reference( verified );
+        {
+            sub0::reduce::Sum<float> sum;
+            feed( verified );
+            check( runner, "sum", sum.count() == verified.size() && isNear( sum.sum(), reference.sum, 1e-7 )
+                , "sum " + std::to_string( sum.sum() ) + " of " + std::to_string( reference.sum ) );
+        }
+        {
+            sub0::reduce::Sum<float> sum;
+            measure( runner, "sum", sum, samples );
+            doNotOptimize( sum.sum() );
+        }
+        {
+            sub0::reduce::MinMax<float> minMax;
+            feed( verified );
+            check( runner, "minmax", minMax.min() == reference.sorted.front() && minMax.max() == reference.sorted.back()
+                , "range " + std::to_string( minMax.min() ) + ".." + std::to_string( minMax.max() ) );
+        }
+        {
+            sub0::reduce::MinMax<float> minMax;
+            measure( runner, "minmax", minMax, samples );
+            doNotOptimize( minMax.max() );
+        }
+        {
+            sub0::reduce::MeanVariance<float> meanVariance;
+            feed( verified );
+            check( runner, "meanvariance", isNear( meanVariance.mean(), reference.mean, 1e-7 ) && isNear( meanVariance.variance(), reference.variance, 1e-6 )
+                , "mean " + std::to_string( meanVariance.mean() ) + " of " + std::to_string( reference.mean )
+                + ", variance " + std::to_string( meanVariance.variance() ) + " of " + std::to_string( reference.variance ) );
+        }
+        {
+            sub0::reduce::MeanVariance<float> meanVariance;
+            measure( runner, "meanvariance", meanVariance, samples );
+            doNotOptimize( meanVariance.variance() );
+        }
+        {
+            sub0::reduce::Histogram<float, cBinCount> histogram( 0.0f, cRange );
+            feed( verified );
+            uint32_t wrongBins = (histogram.underflow() == reference.bins[0U] && histogram.overflow() == reference.bins[cBinCount + 1U]) ? 0U : 1U;
+            for ( uint32_t iBin = 0U; iBin < cBinCount; ++iBin )
+                wrongBins += (histogram.bin( iBin ) == reference.bins[1U + iBin]) ? 0U : 1U;
+            check( runner, "histogram", wrongBins == 0U, std::to_string( wrongBins ) + " bins differ" );
+        }
+        {
+            sub0::reduce::Histogram<float, cBinCount> histogram( 0.0f, cRange );
+            measure( runner, "histogram", histogram, samples );
+            doNotOptimize( histogram.bin( 0U ) );
+        }
+        {
+            sub0::reduce::Percentile<float> percentile;
+            feed( verified );
+            for ( const double fraction : { 0.0, 0.01, 0.5, 0.9, 0.99, 0.999, 1.0 } )
+            {
+                const double expected = reference.quantile( fraction );
+                check( runner, "percentile", isNear( percentile.quantile( fraction ), expected, 1.0 / 32.0 ) //< Half a bucket of 2^-4
+                    , "quantile " + std::to_string( fraction ) + " " + std::to_string( percentile.quantile( fraction ) ) + " of " + std::to_string( expected ) );
+            }
+        }
+        {
+            sub0::reduce::Percentile<float> percentile;
+            measure( runner, "percentile", percentile, samples );
+            doNotOptimize( percentile.quantile( 0.99 ) );
+        }
+    }
+
+} // END: anonymous
+
+SUB0_BENCHMARK( reduce );
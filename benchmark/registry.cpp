@@ -0,0 +1,77 @@
+/** Benchmark of runtime typeId lookup and publish from bytes
+ * @remark Measures TopicRegistry::find over a populated table, and publishing a frame by typeId compared to a typed
+ *  Publish<Data>::publish of the same Data
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#include "benchmark.hpp"
+
+#include <utility> //< std::index_sequence
+
+namespace
+{
+    using namespace sub0::benchmark;
+
+    /** Distinct Data type per topic
+    */
+    template< size_t cIndex >
+    struct Channel
+    {
+        uint64_t timestamp;
+        float value;
+        uint32_t channel;
+    };
+
+    const size_t cTopicCount = 64U; ///< Registered topics
+    const uint32_t cFirstTypeId = 0x600U;
+    const uint32_t cMessageCount = 1024U * 1024U; ///< Lookups or messages per iteration
+
+    /** Name each Channel, the registration outlives the temporary TypeName
+    */
+    template< size_t... cIndices >
+    void registerTopics( std::index_sequence<cIndices...> )
+    {
+        (TypeName< Channel<cIndices> >( uint32_t(cFirstTypeId + cIndices), "Channel" ), ...);
+    }
+
+    class Sink : public sub0::Subscribe< Channel<0> >
+    {
+    public:
+        void receive( const Channel<0>& data ) override
+        { channel_ += data.channel; }
+
+        uint64_t channel_ = 0U;
+    };
+
+    void registry( Runner& runner )
+    {
+        if ( !runner.selected( "registry." ) )
+            return;
+
+        registerTopics( std::make_index_sequence<cTopicCount>() );
+
+        runner.measure( "registry.find", "topics=" + std::to_string(sub0::TopicRegistry::size()), cMessageCount, 0U, [&]
+        {
+            for ( uint32_t iMessage = 0U; iMessage < cMessageCount; ++iMessage )
+                doNotOptimize( sub0::TopicRegistry::find( cFirstTypeId + (iMessage % cTopicCount) ) );
+        } );
+
+        Sink sink;
+        const Channel<0> sample = { 1U, 1.0f, 1U };
+        sub0::Publish< Channel<0> > source;
+        runner.measure( "registry.publish", "typed", cMessageCount, cMessageCount * sizeof(sample), [&]
+        {
+            for ( uint32_t iMessage = 0U; iMessage < cMessageCount; ++iMessage )
+                source.publish( sample );
+        } );
+        runner.measure( "registry.publish", "bytes", cMessageCount, cMessageCount * sizeof(sample), [&]
+        {
+            for ( uint32_t iMessage = 0U; iMessage < cMessageCount; ++iMessage )
+                sub0::TopicRegistry::find( cFirstTypeId )->publish( &sample, sizeof(sample) );
+        } );
+        doNotOptimize( sink.channel_ );
+    }
+
+} // END: anonymous
+
+SUB0_BENCHMARK( registry );
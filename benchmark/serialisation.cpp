@@ -0,0 +1,119 @@
+/** Benchmark of binary serialisation and de-serialisation
+ * @remark Measures BinaryWriter/BinaryReader throughput of DefaultSerialisation for several payload sizes, and
+ *  BufferRegister::find across registry sizes
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#include "benchmark.hpp"
+
+namespace
+{
+    using namespace sub0::benchmark;
+
+    typedef sub0::DefaultSerialisation::Header Header;
+
+    const size_t cRecordingBytes = 16U * 1024U * 1024U; ///< Payload bytes per iteration
+    const uint32_t cLookupCount = 1024U * 1024U; ///< BufferRegister::find per iteration
+
+    template< typename Data >
+    class Recorder : public sub0::StreamSerializer<>
+                   , public sub0::ForwardSubscribe< Data, Recorder<Data> >
+    {
+    public:
+        Recorder( MemoryOStream& stream )
+            : sub0::StreamSerializer<>( stream )
+        {}
+    };
+
+    template< typename Data >
+    class Decoder : public sub0::StreamDeserializer<>
+                  , public sub0::ForwardPublish< Data, Decoder<Data> >
+    {
+    public:
+        Decoder( MemoryIStream& stream )
+            : sub0::StreamDeserializer<>( stream )
+        {}
+    };
+
+    template< typename Data >
+    class Sink : public sub0::Subscribe<Data>
+    {
+    public:
+        void receive( const Data& data ) override
+        { doNotOptimize( data ); }
+    };
+
+    template< size_t cBytes >
+    void measure( Runner& runner, const uint32_t typeId )
+    {
+        typedef Payload<cBytes, 0x700U> Data; //< Tagged apart from Payload types named by other benchmarks
+        TypeName<Data> name( typeId, "Payload" );
+        const std::string params = "payload=" + std::to_string(cBytes);
+        const uint32_t messageCount = static_cast<uint32_t>( cRecordingBytes / cBytes );
+
+        sub0::Publish<Data> source;
+        const Data message = {};
+        MemoryOStream recording;
+        recording.bytes.reserve( messageCount * (sizeof(Data) + sizeof(Header) + 16U) );
+        const auto record = [&]
+        {
+            recording.bytes.clear();
+            for ( uint32_t iMessage = 0U; iMessage < messageCount; ++iMessage )
+                source.publish( message );
+        };
+
+        {
+            Recorder<Data> recorder( recording );
+            record();
+            runner.measure( "serialisation.write", params, messageCount, recording.bytes.size(), record );
+        }
+
+        Sink<Data> sink;
+        MemoryIStream stream( recording.bytes.data(), recording.bytes.size() );
+        Decoder<Data> decoder( stream );
+        runner.measure( "serialisation.read", params, messageCount, recording.bytes.size(), [&]
+        {
+            stream.rewind();
+            decoder.open();
+            while ( decoder.update() ) {}
+        } );
+    }
+
+    void bufferRegisterFind( Runner& runner )
+    {
+        for ( uint32_t registrySize = 1U; registrySize <= 64U; registrySize *= 4U )
+        {
+            sub0::BufferRegister<Header> bufferRegister;
+            std::vector<Header> headers( registrySize );
+            for ( uint32_t iHeader = 0U; iHeader < registrySize; ++iHeader )
+            {
+                headers[iHeader].typeId = 0x1000U + 7U * iHeader;
+                headers[iHeader].dataBytes = 16U;
+                bufferRegister.set( headers[iHeader], sub0::Buffer{ nullptr, nullptr, 16U, 0 } );
+            }
+
+            runner.measure( "serialisation.buffer_register_find", "types=" + std::to_string(registrySize), cLookupCount, 0U, [&]
+            {
+                for ( uint32_t iLookup = 0U; iLookup < cLookupCount; ++iLookup )
+                    doNotOptimize( bufferRegister.find( headers[iLookup % registrySize] ).bufferSize );
+            } );
+        }
+    }
+
+    void serialisation( Runner& runner )
+    {
+        if ( !runner.selected( "serialisation." ) )
+            return;
+
+        measure<16U>( runner, 0x700U );
+        measure<64U>( runner, 0x701U );
+        measure<256U>( runner, 0x702U );
+        measure<1024U>( runner, 0x703U );
+        measure<4096U>( runner, 0x704U );
+
+        bufferRegisterFind( runner );
+    }
+
+} // END: anonymous
+
+SUB0_BENCHMARK( serialisation );
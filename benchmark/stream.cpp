@@ -0,0 +1,130 @@
+/** Benchmark of the ByteSink/ByteSource stream path
+ * @remark Compares serialising through the type-erased OStream/IStream interfaces against the concrete
+ *  utility::MemorySink/MemorySource, both over a fixed buffer so only the dispatch differs
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#include "benchmark.hpp"
+
+namespace
+{
+    using namespace sub0::benchmark;
+
+    /** Small message where per-frame stream calls dominate
+    */
+    struct Sample
+    {
+        uint64_t timestamp;
+        float value;
+        uint32_t channel;
+    };
+
+    const uint32_t cMessageCount = 256U * 1024U; ///< Messages per iteration
+
+    /** Type-erased stream over the same fixed buffer as MemorySink
+    */
+    class BufferOStream : public sub0::utility::OStream
+    {
+    public:
+        explicit BufferOStream( sub0::utility::MemorySink& sink )
+            : sink_(sink)
+        {}
+
+        StreamSize write( const char* const buffer, const StreamSize bufferCount ) override
+        { return static_cast<StreamSize>( sink_.write( buffer, bufferCount ) ); }
+
+        void flush() override
+        {}
+
+    private:
+        sub0::utility::MemorySink& sink_;
+    };
+
+    template< typename ByteSink >
+    class Recorder : public sub0::StreamSerializer< sub0::DefaultSerialisation, sub0::DefaultSerialisation::Writer, ByteSink >
+                   , public sub0::ForwardSubscribe< Sample, Recorder<ByteSink> >
+    {
+    public:
+        Recorder( ByteSink& stream )
+            : sub0::StreamSerializer< sub0::DefaultSerialisation, sub0::DefaultSerialisation::Writer, ByteSink >( stream )
+        {}
+    };
+
+    template< typename ByteSource >
+    class Decoder : public sub0::StreamDeserializer< sub0::DefaultSerialisation, sub0::DefaultSerialisation::Reader, ByteSource >
+                  , public sub0::ForwardPublish< Sample, Decoder<ByteSource> >
+    {
+    public:
+        Decoder( ByteSource& stream )
+            : sub0::StreamDeserializer< sub0::DefaultSerialisation, sub0::DefaultSerialisation::Reader, ByteSource >( stream )
+        {}
+    };
+
+    class Sink : public sub0::Subscribe<Sample>
+    {
+    public:
+        void receive( const Sample& data ) override
+        { channel_ += data.channel; }
+
+        uint64_t channel_ = 0U;
+    };
+
+    void streamDispatch( Runner& runner )
+    {
+        if ( !runner.selected( "stream." ) )
+            return;
+
+        TypeName<Sample> name( 0x400, "Sample" );
+
+        std::vector<char> buffer( cMessageCount * (sizeof(Sample) + 32U) );
+        sub0::utility::MemorySink memorySink( buffer.data(), buffer.size() );
+        sub0::Publish<Sample> source;
+        const auto record = [&]
+        {
+            memorySink.clear();
+            for ( uint32_t iMessage = 0U; iMessage < cMessageCount; ++iMessage )
+            {
+                const Sample sample = { iMessage, float(iMessage), iMessage & 7U };
+                source.publish( sample );
+            }
+        };
+
+        {
+            BufferOStream ostream( memorySink );
+            Recorder<sub0::utility::OStream> recorder( ostream );
+            record();
+            runner.measure( "stream.write", "sink=OStream", cMessageCount, memorySink.size(), record );
+        }
+        {
+            Recorder<sub0::utility::MemorySink> recorder( memorySink );
+            record();
+            runner.measure( "stream.write", "sink=MemorySink", cMessageCount, memorySink.size(), record );
+        }
+
+        Sink sink;
+        {
+            MemoryIStream istream( memorySink.data(), memorySink.size() );
+            Decoder<sub0::utility::IStream> decoder( istream );
+            runner.measure( "stream.read", "source=IStream", cMessageCount, memorySink.size(), [&]
+            {
+                istream.rewind();
+                decoder.open();
+                while ( decoder.update() ) {}
+            } );
+        }
+        {
+            sub0::utility::MemorySource memorySource( memorySink.data(), memorySink.size() );
+            Decoder<sub0::utility::MemorySource> decoder( memorySource );
+            runner.measure( "stream.read", "source=MemorySource", cMessageCount, memorySink.size(), [&]
+            {
+                memorySource.rewind();
+                decoder.open();
+                while ( decoder.update() ) {}
+            } );
+        }
+        doNotOptimize( sink.channel_ );
+    }
+
+} // END: anonymous
+
+SUB0_BENCHMARK( streamDispatch );
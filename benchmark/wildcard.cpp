@@ -0,0 +1,69 @@
+/** Benchmark of wildcard subscription overhead
+ * @remark Measures Broker<Data>::publish to a single typed subscriber with no wildcard subscribed, which costs a null
+ *  check, and with a SubscribeAny recording type and size of every publish
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#include "benchmark.hpp"
+
+namespace
+{
+    using namespace sub0::benchmark;
+
+    struct Sample
+    {
+        uint64_t timestamp;
+        float value;
+        uint32_t channel;
+    };
+
+    const uint32_t cMessageCount = 1024U * 1024U; ///< Messages per iteration
+
+    class Sink : public sub0::Subscribe<Sample>
+    {
+    public:
+        void receive( const Sample& data ) override
+        { channel_ += data.channel; }
+
+        uint64_t channel_ = 0U;
+    };
+
+    class Inspector : public sub0::SubscribeAny
+    {
+    public:
+        void receive( const uint32_t typeId, const void* const, const size_t size ) override
+        { bytes_ += typeId + size; }
+
+        uint64_t bytes_ = 0U;
+    };
+
+    void wildcard( Runner& runner )
+    {
+        if ( !runner.selected( "wildcard." ) )
+            return;
+
+        TypeName<Sample> name( 0x500, "Sample" );
+
+        sub0::Publish<Sample> source;
+        Sink sink;
+        const auto publish = [&]
+        {
+            for ( uint32_t iMessage = 0U; iMessage < cMessageCount; ++iMessage )
+            {
+                const Sample sample = { iMessage, float(iMessage), iMessage & 7U };
+                source.publish( sample );
+            }
+        };
+
+        runner.measure( "wildcard.publish", "wildcards=0", cMessageCount, cMessageCount * sizeof(Sample), publish );
+        {
+            Inspector inspector;
+            runner.measure( "wildcard.publish", "wildcards=1", cMessageCount, cMessageCount * sizeof(Sample), publish );
+            doNotOptimize( inspector.bytes_ );
+        }
+        doNotOptimize( sink.channel_ );
+    }
+
+} // END: anonymous
+
+SUB0_BENCHMARK( wildcard );
@@ -0,0 +1,117 @@
+/** Sub0Pub critical path analysis of causally linked publishes
+ * @remark Opt-in extension of sub0pub.hpp, requires SUB0PUB_CAUSALITY
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#ifndef CROG_SUB0PUB_CAUSALITY_HPP
+#define CROG_SUB0PUB_CAUSALITY_HPP
+
+#include "sub0pub/sub0pub.hpp"
+
+#include <unordered_map> //< std::unordered_map
+#include <vector> //< std::vector
+
+#if !SUB0PUB_CAUSALITY
+#error "sub0pub/causality.hpp requires SUB0PUB_CAUSALITY=true"
+#endif
+
+namespace sub0
+{
+    /** Collects SpanRecord and finds the chain of spans limiting the end-to-end reaction time of a trace
+     * @remark The critical path of a trace runs from its root through the child whose descendants complete last, down
+     *  to the span that gates completion of the whole trace. Spans may be collected in-process via observe() or loaded
+     *  from a recording of several processes, whose utility::Clock must then share an epoch for begin and end to compare.
+     * @note Not thread-safe, collect per thread or serialise calls to add()
+     */
+    class SpanAnalyzer
+    {
+    public:
+        /** Collect a completed span
+         */
+        void add( const SpanRecord& span )
+        { spans_.push_back( span ); }
+
+        /** Causality::Observer collecting into the SpanAnalyzer given as 'analyzer'
+         * e.g. Causality::setObserver( &SpanAnalyzer::observe, &analyzer )
+         */
+        static void observe( const SpanRecord& span, void* const analyzer )
+        { static_cast<SpanAnalyzer*>( analyzer )->add( span ); }
+
+        const std::vector<SpanRecord>& spans() const
+        { return spans_; }
+
+        void clear()
+        { spans_.clear(); }
+
+        /** Find the critical path of a trace
+         * @param traceId  SpanContext::traceId of the trace
+         * @return Spans from the root to the leaf of the critical path, empty if the trace has no collected spans.
+         *  The root is the collected span whose parent was not collected and whose descendants complete last.
+         */
+        std::vector<SpanRecord> criticalPath( const uint64_t traceId ) const
+        {
+            struct Node
+            {
+                const SpanRecord* span;
+                uint64_t subtreeEnd; ///< Latest end of the span and its collected descendants
+                Node* parent;
+                const Node* critical; ///< Child with the latest subtreeEnd
+            };
+
+            std::unordered_map<uint64_t, Node> nodes;
+            for ( const SpanRecord& span : spans_ )
+            {
+                if ( span.context.traceId == traceId )
+                    nodes[span.context.spanId] = Node{ &span, span.end, nullptr, nullptr };
+            }
+            for ( std::pair<const uint64_t, Node>& node : nodes )
+            {
+                const auto iParent = nodes.find( node.second.span->context.parentSpanId );
+                if ( iParent != nodes.end() && &iParent->second != &node.second )
+                    node.second.parent = &iParent->second;
+            }
+
+            // Propagate each end up its ancestors, bounded by the node count to guard against colliding ids
+            const Node* root = nullptr;
+            for ( std::pair<const uint64_t, Node>& node : nodes )
+            {
+                const Node* child = &node.second;
+                size_t depth = 0U;
+                for ( Node* parent = child->parent; parent != nullptr && depth < nodes.size(); parent = parent->parent, ++depth )
+                {
+                    if ( child->subtreeEnd > parent->subtreeEnd )
+                        parent->subtreeEnd = child->subtreeEnd;
+                    if ( parent->critical == nullptr || child->subtreeEnd >= parent->critical->subtreeEnd )
+                        parent->critical = child;
+                    child = parent;
+                }
+            }
+            for ( const std::pair<const uint64_t, Node>& node : nodes )
+            {
+                if ( node.second.parent == nullptr && (root == nullptr || node.second.subtreeEnd > root->subtreeEnd) )
+                    root = &node.second;
+            }
+
+            std::vector<SpanRecord> path;
+            for ( const Node* node = root; node != nullptr && path.size() < nodes.size(); node = node->critical )
+                path.push_back( *node->span );
+            return path;
+        }
+
+        /** @return End-to-end duration of a critical path, from the begin of its root to the latest end along it
+         */
+        static uint64_t duration( const std::vector<SpanRecord>& path )
+        {
+            uint64_t end = 0U;
+            for ( const SpanRecord& span : path )
+                end = std::max( end, span.end );
+            return path.empty() ? 0U : end - path.front().begin;
+        }
+
+    private:
+        std::vector<SpanRecord> spans_;
+    };
+
+} // END: sub0
+
+#endif // CROG_SUB0PUB_CAUSALITY_HPP
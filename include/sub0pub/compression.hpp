@@ -0,0 +1,624 @@
+/** Sub0Pub block compression of serialised streams
+ * @remark Opt-in extension of sub0pub.hpp with a self-contained LZ4-style block codec
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#ifndef CROG_SUB0PUB_COMPRESSION_HPP
+#define CROG_SUB0PUB_COMPRESSION_HPP
+
+#include "sub0pub/sub0pub.hpp"
+
+#include <vector> //< std::vector
+
+#if SUB0PUB_STD
+#include <streambuf> //< std::streambuf
+#endif
+
+namespace sub0
+{
+    /** LZ77 block codec using the LZ4 block sequence format
+     * @remark Sequence: token(4-bit literal count, 4-bit match length - 4), [literal count extension], literals,
+     *  2-byte little-endian match offset, [match length extension]. The last sequence has literals only.
+     */
+    namespace lz
+    {
+        static const size_t cMinMatch = 4U; ///< Shortest encoded match
+        static const size_t cLastLiterals = 5U; ///< Trailing bytes always encoded as literals
+        static const size_t cMatchSearchLimit = 12U; ///< No match may start within this many bytes of the end
+        static const size_t cMaxOffset = 65535U; ///< Furthest match distance
+        static const uint32_t cHashBits = 12U; ///< Match finder table size as power of 2
+
+        /** @return Worst case compressed size of 'size' bytes
+        */
+        constexpr size_t compressBound( const size_t size )
+        { return size + (size / 255U) + 16U; }
+
+        namespace detail
+        {
+            inline uint32_t read32( const char* const data )
+            { uint32_t value; std::memcpy( &value, data, sizeof(value) ); return value; }
+
+            inline uint16_t read16LE( const uint8_t* const data )
+            { return static_cast<uint16_t>( data[0] | (data[1] << 8U) ); }
+
+            inline uint32_t hash( const uint32_t sequence )
+            { return (sequence * 2654435761U) >> (32U - cHashBits); }
+
+            /** Write length extension bytes for a length which exceeded its 4-bit token field
+            */
+            inline uint8_t* writeLength( uint8_t* out, size_t length )
+            {
+                for ( ; length >= 255U; length -= 255U )
+                    *out++ = 255U;
+                *out++ = static_cast<uint8_t>(length);
+                return out;
+            }
+
+            /** Read length extension bytes
+             * @return False if input ends within the length
+            */
+            inline bool readLength( const uint8_t*& in, const uint8_t* const inEnd, size_t& length )
+            {
+                uint8_t byte;
+                do
+                {
+                    if ( in == inEnd )
+                        return false;
+                    byte = *in++;
+                    length += byte;
+                } while ( byte == 255U );
+                return true;
+            }
+
+            /** Encode a sequence of literals followed by an optional match
+            */
+            inline uint8_t* writeSequence( uint8_t* out, const char* const literals, const size_t literalCount, const size_t offset, const size_t matchLength )
+            {
+                uint8_t* const token = out++;
+                *token = static_cast<uint8_t>( std::min<size_t>( literalCount, 15U ) << 4U );
+                if ( literalCount >= 15U )
+                    out = writeLength( out, literalCount - 15U );
+                std::memcpy( out, literals, literalCount );
+                out += literalCount;
+
+                if ( matchLength != 0U )
+                {
+                    *out++ = static_cast<uint8_t>( offset );
+                    *out++ = static_cast<uint8_t>( offset >> 8U );
+                    const size_t length = matchLength - cMinMatch;
+                    *token |= static_cast<uint8_t>( std::min<size_t>( length, 15U ) );
+                    if ( length >= 15U )
+                        out = writeLength( out, length - 15U );
+                }
+                return out;
+            }
+        } // END: detail
+
+        /** Compress a block
+         * @param[in] source  Bytes to compress
+         * @param[in] sourceSize  Count of bytes in source
+         * @param[out] destination  Compressed output of at least compressBound(sourceSize) bytes
+         * @return Count of compressed bytes written to destination
+         */
+        inline size_t compress( const char* const source, const size_t sourceSize, char* const destination )
+        {
+            uint8_t* out = reinterpret_cast<uint8_t*>(destination);
+            size_t anchor = 0U; ///< Start of pending literals
+
+            if ( sourceSize > cMatchSearchLimit )
+            {
+                uint32_t table[1U << cHashBits] = {}; ///< Last position of each hashed 4-byte sequence
+                const size_t matchStartLimit = sourceSize - cMatchSearchLimit;
+                const size_t matchEndLimit = sourceSize - cLastLiterals;
+
+                for ( size_t position = 0U; position < matchStartLimit; )
+                {
+                    const uint32_t sequence = detail::read32( source + position );
+                    const uint32_t iHash = detail::hash( sequence );
+                    size_t candidate = table[iHash];
+                    table[iHash] = static_cast<uint32_t>(position);
+
+                    if ( candidate >= position || position - candidate > cMaxOffset || detail::read32( source + candidate ) != sequence )
+                    {
+                        position += 1U + ((position - anchor) >> 6U); //< Accelerate through incompressible data
+                        continue;
+                    }
+
+                    // Extend match backwards into pending literals, then forwards
+                    size_t matchStart = position;
+                    while ( matchStart > anchor && candidate > 0U && source[matchStart - 1U] == source[candidate - 1U] )
+                    {
+                        --matchStart;
+                        --candidate;
+                    }
+                    size_t matchEnd = position + cMinMatch;
+                    for ( size_t reference = candidate + (matchEnd - matchStart); matchEnd < matchEndLimit && source[matchEnd] == source[reference]; ++reference )
+                        ++matchEnd;
+
+                    out = detail::writeSequence( out, source + anchor, matchStart - anchor, matchStart - candidate, matchEnd - matchStart );
+                    anchor = position = matchEnd;
+
+                    if ( position >= 2U && position < matchStartLimit )
+                        table[ detail::hash( detail::read32( source + position - 2U ) ) ] = static_cast<uint32_t>(position - 2U);
+                }
+            }
+
+            out = detail::writeSequence( out, source + anchor, sourceSize - anchor, 0U, 0U );
+            return static_cast<size_t>( out - reinterpret_cast<uint8_t*>(destination) );
+        }
+
+        /** Decompress a block
+         * @remark Input is fully bounds checked so corrupt input fails rather than overruns
+         * @param[in] source  Compressed bytes
+         * @param[in] sourceSize  Count of bytes in source
+         * @param[out] destination  Decompressed output of exactly destinationSize bytes
+         * @param[in] destinationSize  Decompressed size of the block
+         * @return True if the block decoded to exactly destinationSize bytes
+         */
+        inline bool decompress( const char* const source, const size_t sourceSize, char* const destination, const size_t destinationSize )
+        {
+            const uint8_t* in = reinterpret_cast<const uint8_t*>(source);
+            const uint8_t* const inEnd = in + sourceSize;
+            char* out = destination;
+            char* const outEnd = destination + destinationSize;
+
+            while ( in < inEnd )
+            {
+                const uint8_t token = *in++;
+
+                size_t literalCount = token >> 4U;
+                if ( literalCount == 15U && !detail::readLength( in, inEnd, literalCount ) )
+                    return false;
+                if ( literalCount > static_cast<size_t>(inEnd - in) || literalCount > static_cast<size_t>(outEnd - out) )
+                    return false;
+
+                if ( literalCount <= 16U && (inEnd - in) >= 16 && (outEnd - out) >= 16 )
+                    std::memcpy( out, in, 16U ); //< Fixed size copy of short literal runs
+                else
+                    std::memcpy( out, in, literalCount );
+                in += literalCount;
+                out += literalCount;
+
+                if ( in == inEnd )
+                    break; //< Last sequence has no match
+
+                if ( inEnd - in < 2 )
+                    return false;
+                const size_t offset = detail::read16LE( in );
+                in += 2;
+                if ( offset == 0U || offset > static_cast<size_t>(out - destination) )
+                    return false;
+
+                size_t matchLength = token & 15U;
+                if ( matchLength == 15U && !detail::readLength( in, inEnd, matchLength ) )
+                    return false;
+                matchLength += cMinMatch;
+                if ( matchLength > static_cast<size_t>(outEnd - out) )
+                    return false;
+
+                const char* match = out - offset;
+                char* const matchEnd = out + matchLength;
+                if ( offset >= 8U && (outEnd - matchEnd) >= 8 )
+                {
+                    // Non-overlapping 8-byte chunks, may write up to 7 bytes beyond matchEnd which are later overwritten
+                    for ( ; out < matchEnd; out += 8, match += 8 )
+                        std::memcpy( out, match, 8U );
+                }
+                else
+                {
+                    for ( ; out < matchEnd; ++out, ++match )
+                        *out = *match; //< Overlapping copy repeats the pattern
+                }
+                out = matchEnd;
+            }
+
+            return out == outEnd;
+        }
+
+    } // END: lz
+
+    /** Header preceding each compressed block
+    */
+    struct BlockHeader
+    {
+        static const uint32_t cMaxRawBytes = 16U * 1024U * 1024U; ///< Largest block written, bounds the decompression buffer of a reader
+
+        uint32_t magic = sub0::utility::FourCC<'S', '0', 'L', 'Z'>::value; ///< Identifies a Sub0 compressed block
+        uint32_t rawBytes = 0U; ///< Size of the block after decompression
+        uint32_t storedBytes = 0U; ///< Size of the block in the stream, equal to rawBytes when stored uncompressed
+
+        bool isValid() const
+        { return magic == BlockHeader().magic && rawBytes <= cMaxRawBytes && storedBytes <= lz::compressBound(rawBytes); }
+    };
+
+    namespace detail
+    {
+#if SUB0PUB_STD
+        /** Stream buffer over a growable byte vector
+        */
+        class BlockBuffer : public std::streambuf
+        {
+        public:
+            explicit BlockBuffer( std::vector<char>& bytes )
+                : bytes_(bytes)
+            {}
+
+            /** Reset get area to the content of the vector
+            */
+            void reset()
+            { setg( bytes_.data(), bytes_.data(), bytes_.data() + bytes_.size() ); }
+
+        protected:
+            std::streamsize xsputn( const char* const buffer, const std::streamsize count ) override
+            {
+                bytes_.insert( bytes_.end(), buffer, buffer + count );
+                return count;
+            }
+
+            int_type overflow( const int_type character ) override
+            {
+                if ( !traits_type::eq_int_type( character, traits_type::eof() ) )
+                    bytes_.push_back( traits_type::to_char_type(character) );
+                return traits_type::not_eof( character );
+            }
+
+        private:
+            std::vector<char>& bytes_;
+        };
+
+        /** Output stream appending into a block
+        */
+        class BlockOStream : public std::ostream
+        {
+        public:
+            explicit BlockOStream( std::vector<char>& bytes )
+                : std::ostream( nullptr ), buffer_(bytes)
+            { rdbuf( &buffer_ ); }
+
+        private:
+            BlockBuffer buffer_;
+        };
+
+        /** Input stream reading from a decompressed block
+        */
+        class BlockIStream : public std::istream
+        {
+        public:
+            explicit BlockIStream( std::vector<char>& bytes )
+                : std::istream( nullptr ), buffer_(bytes)
+            { rdbuf( &buffer_ ); }
+
+            /** Read from start of the block content
+            */
+            void reset()
+            {
+                buffer_.reset();
+                clear();
+            }
+
+            bool isEof()
+            { return buffer_.in_avail() <= 0; }
+
+        private:
+            BlockBuffer buffer_;
+        };
+#else
+        /** Output stream appending into a block
+        */
+        class BlockOStream : public utility::OStream
+        {
+        public:
+            explicit BlockOStream( std::vector<char>& bytes )
+                : bytes_(bytes)
+            {}
+
+            StreamSize write( const char* const buffer, const StreamSize bufferCount ) override
+            {
+                bytes_.insert( bytes_.end(), buffer, buffer + bufferCount );
+                return bufferCount;
+            }
+
+            void flush() override
+            {}
+
+        private:
+            std::vector<char>& bytes_;
+        };
+
+        /** Input stream reading from a decompressed block
+        */
+        class BlockIStream : public utility::IStream
+        {
+        public:
+            explicit BlockIStream( std::vector<char>& bytes )
+                : bytes_(bytes), position_(0U)
+            {}
+
+            /** Read from start of the block content
+            */
+            void reset()
+            { position_ = 0U; }
+
+            StreamSize read( char* const buffer, const StreamSize bufferCount ) override
+            {
+                const StreamSize count = static_cast<StreamSize>( std::min<size_t>( bufferCount, bytes_.size() - position_ ) );
+                if ( count != 0U )
+                    std::memcpy( buffer, bytes_.data() + position_, count );
+                position_ += count;
+                return count;
+            }
+
+            StreamSize readline( char* const, const StreamSize ) override
+            { return 0U; } ///< @note Binary block content only
+
+            StreamSize ignore( const StreamSize bufferCount ) override
+            {
+                const StreamSize count = static_cast<StreamSize>( std::min<size_t>( bufferCount, bytes_.size() - position_ ) );
+                position_ += count;
+                return count;
+            }
+
+            StreamSize ignore( const StreamSize bufferCount, const char delimiter ) override
+            {
+                StreamSize count = 0U;
+                while ( count < bufferCount && position_ < bytes_.size() )
+                {
+                    ++count;
+                    if ( bytes_[position_++] == delimiter )
+                        break;
+                }
+                return count;
+            }
+
+            bool isEof() override
+            { return position_ == bytes_.size(); }
+
+        private:
+            std::vector<char>& bytes_;
+            size_t position_;
+        };
+#endif
+    } // END: detail
+
+    /** Batches whole frames of a protocol writer into compressed blocks
+     * @remark A block is emitted once Config::blockBytes of frames are pending, on update() or on close(). Frames
+     *  never straddle blocks so each block is independently decodable e.g. As a segment by ParallelDeserializer.
+     * @tparam  ProtocolWriter  Writer of uncompressed frames e.g. DefaultSerialisation::Writer
+     */
+    template< typename ProtocolWriter >
+    class BlockCompressionWriter
+    {
+    public:
+        struct Config
+        {
+            size_t blockBytes = 64U * 1024U; ///< Pending frame bytes which trigger compression of a block, at most BlockHeader::cMaxRawBytes
+        };
+
+    public:
+        BlockCompressionWriter()
+            : writer_()
+            , config_()
+            , pending_()
+            , pendingStream_( pending_ )
+            , compressed_()
+        {}
+
+        template<typename ByteSink>
+        bool configure( ByteSink& stream, const Config& config )
+        {
+            if ( config.blockBytes == 0U || config.blockBytes > BlockHeader::cMaxRawBytes )
+                return false;
+            config_ = config;
+            return true;
+        }
+
+        template<typename Data_t, typename ByteSink>
+        inline bool write( ByteSink& stream, const Data_t& data )
+        {
+            if ( !writer_.write( pendingStream_, data ) )
+                return false;
+            return (pending_.size() < config_.blockBytes) || writeBlock( stream );
+        }
+
+        template<typename ByteSink>
+        bool open( ByteSink& stream )
+        {
+            pending_.clear();
+            return writer_.open( pendingStream_ );
+        }
+
+        /** Emit pending frames as a block e.g. Periodically on a live link to bound latency
+        */
+        template<typename ByteSink>
+        bool update( ByteSink& stream )
+        {
+            return pending_.empty() || writeBlock( stream );
+        }
+
+        template<typename ByteSink>
+        void close( ByteSink& stream )
+        {
+            writer_.close( pendingStream_ );
+            if ( !pending_.empty() )
+                writeBlock( stream );
+        }
+
+    private:
+        template<typename ByteSink>
+        bool writeBlock( ByteSink& stream )
+        {
+            if ( pending_.size() > BlockHeader::cMaxRawBytes )
+            {
+                pending_.clear();
+                const char* const failureMessage = "Sub0Pub - Compressed block exceeds BlockHeader::cMaxRawBytes - frame too large to compress";
+#if __cpp_exceptions
+                throw std::runtime_error(failureMessage);
+#elif SUB0PUB_ASSERT
+                assert((void*)0 == failureMessage);
+#endif
+                return false;
+            }
+
+            compressed_.resize( lz::compressBound( pending_.size() ) );
+            const size_t compressedBytes = lz::compress( pending_.data(), pending_.size(), compressed_.data() );
+            const bool stored = (compressedBytes >= pending_.size()); //< Incompressible blocks are stored
+
+            BlockHeader header;
+            header.rawBytes = static_cast<uint32_t>( pending_.size() );
+            header.storedBytes = static_cast<uint32_t>( stored ? pending_.size() : compressedBytes );
+            const char* const block = stored ? pending_.data() : compressed_.data();
+
+            const bool written = utility::write( stream, header )
+                && utility::write( stream, block, header.storedBytes );
+            pending_.clear();
+            return written;
+        }
+
+    private:
+        ProtocolWriter writer_;
+        Config config_;
+        std::vector<char> pending_; ///< Uncompressed frames of the pending block
+        detail::BlockOStream pendingStream_; ///< Stream writer_ serialises into pending_
+        std::vector<char> compressed_;
+    };
+
+    /** Decompresses blocks written by BlockCompressionWriter in front of a protocol reader
+     * @tparam  ProtocolReader  Reader of uncompressed frames e.g. DefaultSerialisation::Reader
+     */
+    template< typename ProtocolReader >
+    class BlockCompressionReader
+    {
+    public:
+        using Config = detail::Empty; //< Not configurable by default
+
+    public:
+        BlockCompressionReader()
+            : reader_()
+            , header_()
+            , headerBytes_(0U)
+            , stored_()
+            , storedBytes_(0U)
+            , block_()
+            , blockStream_( block_ )
+        {}
+
+        template<typename ByteSource>
+        bool open( ByteSource& stream )
+        {
+            headerBytes_ = 0U;
+            storedBytes_ = 0U;
+            block_.clear();
+            blockStream_.reset();
+            return reader_.open( blockStream_ );
+        }
+
+        /** Read from the stream
+         * @return True = Completed reading a payload, False = Need more data
+        */
+        template<typename ByteSource>
+        bool update( ByteSource& stream )
+        {
+            for ( ;; )
+            {
+                if ( reader_.update( blockStream_ ) )
+                    return true;
+                if ( !blockStream_.isEof() || !readBlock( stream ) )
+                    return false; //< Sync-lost in frames or need more data
+            }
+        }
+
+        template < typename Data >
+        void setDataPublisher( Data& dataBuffer, IPublish& publisher )
+        {
+            reader_.setDataPublisher( dataBuffer, publisher );
+        }
+
+        template<typename ByteSource>
+        bool close( ByteSource& stream )
+        {
+            return reader_.close( blockStream_ );
+        }
+
+    private:
+        /** Read the next block from the stream and decompress it into block_
+         * @return True when a complete block is available, false if more data is needed
+        */
+        template<typename ByteSource>
+        bool readBlock( ByteSource& stream )
+        {
+            if ( headerBytes_ < sizeof(header_) )
+            {
+                headerBytes_ += utility::read( stream, reinterpret_cast<char*>(&header_) + headerBytes_, sizeof(header_) - headerBytes_ );
+                if ( headerBytes_ < sizeof(header_) )
+                    return false;
+
+                if ( !header_.isValid() )
+                {
+                    headerBytes_ = 0U;
+                    const char* const failureMessage = "Sub0Pub - Compressed block header mismatch - stream corruption or incompatible data-stream";
+#if __cpp_exceptions
+                    throw std::runtime_error(failureMessage);
+#elif SUB0PUB_ASSERT
+                    assert((void*)0 == failureMessage);
+#endif
+                    return false;
+                }
+                stored_.resize( header_.storedBytes );
+                storedBytes_ = 0U;
+            }
+
+            storedBytes_ += utility::read( stream, stored_.data() + storedBytes_, header_.storedBytes - storedBytes_ );
+            if ( storedBytes_ < header_.storedBytes )
+                return false;
+            headerBytes_ = 0U;
+
+            if ( header_.storedBytes == header_.rawBytes )
+                block_.swap( stored_ );
+            else
+            {
+                block_.resize( header_.rawBytes );
+                if ( !lz::decompress( stored_.data(), stored_.size(), block_.data(), block_.size() ) )
+                {
+                    block_.clear();
+                    const char* const failureMessage = "Sub0Pub - Compressed block corrupt - stream corruption or incompatible data-stream";
+#if __cpp_exceptions
+                    throw std::runtime_error(failureMessage);
+#elif SUB0PUB_ASSERT
+                    assert((void*)0 == failureMessage);
+#endif
+                    return false;
+                }
+            }
+            blockStream_.reset();
+            return true;
+        }
+
+    private:
+        ProtocolReader reader_;
+        BlockHeader header_; ///< Header of block being read
+        size_t headerBytes_; ///< Bytes of header_ read
+        std::vector<char> stored_; ///< Block as stored in the stream
+        size_t storedBytes_; ///< Bytes of stored_ read
+        std::vector<char> block_; ///< Decompressed frames
+        detail::BlockIStream blockStream_; ///< Stream reader_ de-serialises from block_
+    };
+
+    /** Block compressed variant of a binary protocol
+     * @remark Frames of Protocol are batched into LZ compressed blocks each preceded by a BlockHeader
+     * @tparam  Protocol  Uncompressed protocol e.g. DefaultSerialisation, MessageInfoSerialisation
+     */
+    template< typename Protocol = DefaultSerialisation >
+    struct CompressedSerialisation
+    {
+        typedef typename Protocol::Prefix Prefix;
+        typedef typename Protocol::Header Header;
+        typedef typename Protocol::Postfix Postfix;
+        typedef sub0::BlockHeader BlockHeader; ///< Frames are batched into independently decodable blocks
+
+        using Writer = BlockCompressionWriter<typename Protocol::Writer>;
+        using Reader = BlockCompressionReader<typename Protocol::Reader>;
+    };
+
+} // END: sub0
+
+#endif
@@ -0,0 +1,406 @@
+/** Sub0Pub delta encoding of consecutive messages
+ * @remark Opt-in extension of sub0pub.hpp encoding each payload as the XOR against the previous payload of the type
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#ifndef CROG_SUB0PUB_DELTA_HPP
+#define CROG_SUB0PUB_DELTA_HPP
+
+#include "sub0pub/sub0pub.hpp"
+
+#include <vector> //< std::vector
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h> //< _mm_cmpeq_epi8
+#define SUB0PUB_DELTA_SSE2 1
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h> //< _mm256_cmpeq_epi8
+#endif
+
+/** Enable delta encoding of Data by DeltaSerialisation
+ * @note Must be used from the global namespace
+ * @param  Data  Fully qualified Data type e.g. SUB0_DELTA_ENCODING(my::Pose)
+ */
+#define SUB0_DELTA_ENCODING(Data) \
+    namespace sub0 { template<> struct HasDeltaEncoding<Data> : std::true_type {}; }
+
+namespace sub0
+{
+    /** Enables delta encoding of 'Data' by DeltaSerialisation
+     * @remark Enable for a type with SUB0_DELTA_ENCODING(Data), other types are always written as keyframes
+     * @tparam Data  Data type which is delta encoded
+     */
+    template< typename Data >
+    struct HasDeltaEncoding : std::false_type {};
+
+    /** XOR delta codec
+     * @remark Encoding: sequence of [varint unchanged-count][varint changed-count][changed-count XOR bytes]. Bytes
+     *  after the last changed run are unchanged.
+     */
+    namespace delta
+    {
+        namespace detail
+        {
+            /** @return Index of first byte from 'position' where current and previous differ, or 'size'
+            */
+            inline size_t skipUnchanged( const uint8_t* const current, const uint8_t* const previous, size_t position, const size_t size )
+            {
+#if defined(__AVX2__)
+                for ( ; position + 32U <= size; position += 32U )
+                {
+                    const __m256i equal = _mm256_cmpeq_epi8( _mm256_loadu_si256( reinterpret_cast<const __m256i*>(current + position) )
+                                                           , _mm256_loadu_si256( reinterpret_cast<const __m256i*>(previous + position) ) );
+                    if ( static_cast<uint32_t>( _mm256_movemask_epi8( equal ) ) != 0xFFFFFFFFU )
+                        break; //< Located within the narrower loops
+                }
+#endif
+#if SUB0PUB_DELTA_SSE2
+                for ( ; position + 16U <= size; position += 16U )
+                {
+                    const __m128i equal = _mm_cmpeq_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i*>(current + position) )
+                                                        , _mm_loadu_si128( reinterpret_cast<const __m128i*>(previous + position) ) );
+                    const uint32_t changed = ~static_cast<uint32_t>( _mm_movemask_epi8( equal ) ) & 0xFFFFU;
+                    if ( changed != 0U )
+                    {
+                        while ( current[position] == previous[position] )
+                            ++position;
+                        return position;
+                    }
+                }
+#endif
+                while ( position < size && current[position] == previous[position] )
+                    ++position;
+                return position;
+            }
+
+            /** @return Index of the end of a changed run from 'position', a run ends at 2 consecutive unchanged bytes
+            */
+            inline size_t skipChanged( const uint8_t* const current, const uint8_t* const previous, size_t position, const size_t size )
+            {
+                for ( ; position < size; ++position )
+                {
+                    if ( current[position] == previous[position] && (position + 1U == size || current[position + 1U] == previous[position + 1U]) )
+                        break;
+                }
+                return position;
+            }
+
+            inline uint8_t* writeVarint( uint8_t* out, size_t value )
+            {
+                for ( ; value >= 0x80U; value >>= 7U )
+                    *out++ = static_cast<uint8_t>( value | 0x80U );
+                *out++ = static_cast<uint8_t>( value );
+                return out;
+            }
+
+            inline bool readVarint( const uint8_t*& in, const uint8_t* const inEnd, size_t& value )
+            {
+                value = 0U;
+                for ( uint32_t shift = 0U; in != inEnd && shift < 64U; shift += 7U )
+                {
+                    const uint8_t byte = *in++;
+                    value |= static_cast<size_t>( byte & 0x7FU ) << shift;
+                    if ( (byte & 0x80U) == 0U )
+                        return true;
+                }
+                return false;
+            }
+        } // END: detail
+
+        /** @return Worst case encoded size of a 'size' byte payload
+        */
+        constexpr size_t encodeBound( const size_t size )
+        { return size + 2U * (size / 3U + 1U) * 10U; }
+
+        /** Encode 'current' as the difference from 'previous'
+         * @param[in] current  Payload to encode
+         * @param[in] previous  Previously encoded payload
+         * @param[in] size  Bytes of both payloads
+         * @param[out] out  Encoded output of at least encodeBound(size) bytes
+         * @return Count of bytes written to out
+         */
+        inline size_t encode( const void* const current, const void* const previous, const size_t size, void* const out )
+        {
+            const uint8_t* const currentBytes = static_cast<const uint8_t*>(current);
+            const uint8_t* const previousBytes = static_cast<const uint8_t*>(previous);
+            uint8_t* write = static_cast<uint8_t*>(out);
+
+            for ( size_t position = 0U; ; )
+            {
+                const size_t changedBegin = detail::skipUnchanged( currentBytes, previousBytes, position, size );
+                if ( changedBegin == size )
+                    break;
+                const size_t changedEnd = detail::skipChanged( currentBytes, previousBytes, changedBegin, size );
+
+                write = detail::writeVarint( write, changedBegin - position );
+                write = detail::writeVarint( write, changedEnd - changedBegin );
+                for ( size_t iByte = changedBegin; iByte < changedEnd; ++iByte )
+                    *write++ = currentBytes[iByte] ^ previousBytes[iByte];
+                position = changedEnd;
+            }
+            return static_cast<size_t>( write - static_cast<uint8_t*>(out) );
+        }
+
+        /** Apply an encoded difference onto the previous payload in-place
+         * @param[in] encoded  Output of encode()
+         * @param[in] encodedSize  Bytes of encoded
+         * @param[in,out] payload  Previous payload, updated to the encoded payload
+         * @param[in] size  Bytes of payload
+         * @return False if encoded is corrupt, payload may be partially updated
+         */
+        inline bool decode( const void* const encoded, const size_t encodedSize, void* const payload, const size_t size )
+        {
+            const uint8_t* in = static_cast<const uint8_t*>(encoded);
+            const uint8_t* const inEnd = in + encodedSize;
+            uint8_t* const payloadBytes = static_cast<uint8_t*>(payload);
+
+            for ( size_t position = 0U; in != inEnd; )
+            {
+                size_t unchanged, changed;
+                if ( !detail::readVarint( in, inEnd, unchanged ) || !detail::readVarint( in, inEnd, changed ) )
+                    return false;
+                if ( unchanged > size - position || changed > size - position - unchanged || changed > static_cast<size_t>(inEnd - in) )
+                    return false;
+
+                position += unchanged;
+                for ( size_t iByte = 0U; iByte < changed; ++iByte )
+                    payloadBytes[position + iByte] ^= in[iByte];
+                position += changed;
+                in += changed;
+            }
+            return true;
+        }
+    } // END: delta
+
+    /** Writes binary frames with payloads of HasDeltaEncoding types encoded against the previous payload of the type
+     * @remark Header_t::deltaBytes is the size of the encoded payload, or Header_t::cKeyframe when the full payload of
+     *  Header_t::dataBytes follows. The first payload of each type, every Config::keyframeInterval payload and any
+     *  payload which does not encode smaller is written as a keyframe.
+     * @see DeltaSerialisation
+     */
+    template< typename Prefix_t
+            , typename Header_t
+            , typename Postfix_t >
+    class DeltaWriter : public BinaryWriter<Prefix_t, Header_t, Postfix_t>
+    {
+    public:
+        struct Config
+        {
+            uint32_t keyframeInterval = 100U; ///< Payloads of a type between keyframes allowing readers to resync, 0 for first payload only
+        };
+
+    public:
+        DeltaWriter()
+            : BinaryWriter<Prefix_t, Header_t, Postfix_t>()
+            , config_()
+            , histories_()
+            , encoded_()
+        {}
+
+        template<typename ByteSink>
+        bool configure( ByteSink& stream, const Config& config )
+        {
+            config_ = config;
+            return true;
+        }
+
+        /** Output header and delta encoded pay-load for data as binary
+         * @param stream  Stream to write into
+         * @param data  Data to construct a header record and data payload for
+         */
+        template<typename Data_t, typename ByteSink>
+        inline bool write(ByteSink& stream, const Data_t& data)
+        {
+            Header_t header(data);
+            if constexpr ( HasDeltaEncoding<Data_t>::value )
+            {
+                History& history = findHistory( header.typeId );
+                const bool keyframe = history.previous.empty()
+                    || (config_.keyframeInterval != 0U && history.sinceKeyframe >= config_.keyframeInterval);
+
+                if ( !keyframe )
+                {
+                    encoded_.resize( delta::encodeBound( sizeof(data) ) );
+                    const size_t encodedBytes = delta::encode( &data, history.previous.data(), sizeof(data), encoded_.data() );
+                    if ( encodedBytes < sizeof(data) )
+                    {
+                        header.deltaBytes = static_cast<uint32_t>(encodedBytes);
+                        std::memcpy( history.previous.data(), &data, sizeof(data) );
+                        ++history.sinceKeyframe;
+
+                        return utility::write<Prefix_t>(stream)
+                            && utility::write(stream, header )
+                            && utility::write(stream, encoded_.data(), encodedBytes )
+                            && utility::write<Postfix_t>(stream);
+                    }
+                }
+
+                history.previous.resize( sizeof(data) );
+                std::memcpy( history.previous.data(), &data, sizeof(data) );
+                history.sinceKeyframe = 0U;
+            }
+
+            return BinaryWriter<Prefix_t, Header_t, Postfix_t>::write(stream, header, data);
+        }
+
+        template<typename ByteSink>
+        bool open( ByteSink& stream )
+        {
+            histories_.clear(); //< Stream starts from keyframes
+            return true;
+        }
+
+        template<typename ByteSink>
+        void close( ByteSink& stream )
+        {
+            histories_.clear();
+        }
+
+    private:
+        /** Last payload written of a type
+        */
+        struct History
+        {
+            uint32_t typeId;
+            uint32_t sinceKeyframe; ///< Count of delta payloads since the last keyframe
+            std::vector<uint8_t> previous; ///< Payload deltas are encoded against, empty before the first keyframe
+        };
+
+        History& findHistory( const uint32_t typeId )
+        {
+            typename std::vector<History>::iterator iFind = std::lower_bound( histories_.begin(), histories_.end(), typeId
+                , []( const History& lhs, const uint32_t rhs ) { return lhs.typeId < rhs; } );
+            if ( iFind == histories_.end() || iFind->typeId != typeId )
+                iFind = histories_.insert( iFind, History{ typeId, 0U, {} } );
+            return *iFind;
+        }
+
+    private:
+        Config config_;
+        std::vector<History> histories_; ///< Sorted by typeId
+        std::vector<char> encoded_; ///< Encoded payload being written
+    };
+
+    /** Buffer register decoding payloads written by DeltaWriter
+     * @remark Keyframes are read directly into the Data buffer. Deltas are read into a staging buffer and applied onto
+     *  the Data buffer which retains the previous payload. Deltas of a type received before its first keyframe e.g.
+     *  When joining a live stream, are discarded.
+     */
+    template< typename Header_t, uint_fast16_t cMaxDataBufferCount = 64U >
+    class DeltaBufferRegister : public BufferRegister<Header_t, cMaxDataBufferCount>
+    {
+    public:
+        DeltaBufferRegister()
+            : BufferRegister<Header_t, cMaxDataBufferCount>()
+            , staging_()
+            , target_()
+            , synced_()
+            , syncedEnd_(synced_.begin())
+        {}
+
+        template < typename Data >
+        void set(Data& buffer, IPublish& publisher, const int_least16_t paddingSize = 0U )
+        {
+            BufferRegister<Header_t, cMaxDataBufferCount>::set( buffer, publisher, paddingSize );
+            if ( staging_.size() < sizeof(buffer) )
+                staging_.resize( sizeof(buffer) ); //< Accepted deltas are smaller than the payload
+        }
+
+        /** Find the buffer a payload is read into, the staging buffer for deltas
+        */
+        Buffer find(const Header_t header)
+        {
+            const Buffer buffer = BufferRegister<Header_t, cMaxDataBufferCount>::find( header );
+            if ( header.deltaBytes == Header_t::cKeyframe || buffer.buffer == nullptr || header.deltaBytes > staging_.size() )
+                return buffer; ///< @note Oversize deltas are rejected as an unrecognised payload
+
+            target_ = buffer;
+            return Buffer{ buffer.publisher, staging_.data(), static_cast<uint_least16_t>(header.deltaBytes), 0, buffer.typeId };
+        }
+
+        bool close()
+        {
+            syncedEnd_ = synced_.begin(); //< Next stream starts from keyframes
+            return BufferRegister<Header_t, cMaxDataBufferCount>::close();
+        }
+
+        /** Publish a keyframe, or apply and publish a delta
+         * @param header  Header data of the completed payload
+         * @param publisher  Publisher of the completed buffer
+         */
+        void publish(const Header_t& header, IPublish& publisher)
+        {
+            const typename Synced::iterator iSynced = std::find( synced_.begin(), syncedEnd_, &publisher );
+            if ( header.deltaBytes == Header_t::cKeyframe )
+            {
+                if ( iSynced == syncedEnd_ && syncedEnd_ != synced_.end() )
+                    *syncedEnd_++ = &publisher;
+                publisher.publish();
+            }
+            else if ( iSynced != syncedEnd_ )
+            {
+                if ( delta::decode( staging_.data(), header.deltaBytes, target_.buffer, target_.bufferSize ) )
+                    publisher.publish();
+                else
+                {
+                    std::copy( iSynced + 1, syncedEnd_, iSynced ); //< Discard deltas until the next keyframe
+                    --syncedEnd_;
+
+                    const char* const failureMessage = "Sub0Pub - Delta payload corrupt - stream corruption or incompatible data-stream";
+#if __cpp_exceptions
+                    throw std::runtime_error(failureMessage);
+#elif SUB0PUB_ASSERT
+                    assert((void*)0 == failureMessage);
+#endif
+                }
+            }
+        }
+
+    private:
+        typedef std::array<const IPublish*, cMaxDataBufferCount> Synced;
+
+        std::vector<char> staging_; ///< Delta payload being read
+        Buffer target_; ///< Data buffer the staged delta applies to
+        Synced synced_; ///< Publishers which have received a keyframe
+        typename Synced::iterator syncedEnd_;
+    };
+
+    /** Binary protocol delta encoding payloads of HasDeltaEncoding types
+     * @remark Extends DefaultSerialisation with the encoded size of delta payloads in the Header. Suited to high-rate
+     *  topics where consecutive values differ in few bytes e.g. Pose, counters and status words.
+     * @note Deltas depend on previous frames so a recording must be read from its start
+     * @see HasDeltaEncoding
+     */
+    struct DeltaSerialisation
+    {
+        typedef DefaultSerialisation::Prefix Prefix;
+
+        /** Header containing signal type information and delta size
+        */
+        struct Header : DefaultSerialisation::Header
+        {
+            static const uint32_t cKeyframe = UINT32_MAX; ///< deltaBytes of a payload written in full
+
+            uint32_t deltaBytes; ///< Bytes of the delta payload, cKeyframe when DefaultSerialisation::Header::dataBytes follow
+
+            Header() = default;
+
+            /** header for specified Data type
+            */
+            template<typename Data>
+            Header( const Data& data )
+                : DefaultSerialisation::Header(data)
+                , deltaBytes(cKeyframe)
+            {}
+        };
+
+        typedef DefaultSerialisation::Postfix Postfix;
+
+        using Writer = DeltaWriter<Prefix, Header, Postfix>;
+        using Reader = BinaryReader<Prefix, Header, Postfix, DeltaBufferRegister<Header> >;
+    };
+
+} // END: sub0
+
+#endif
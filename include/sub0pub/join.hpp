@@ -0,0 +1,264 @@
+/** Sub0Pub time-aligned join of several topics delivered as one set
+ * @remark Opt-in extension of sub0pub.hpp
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#ifndef CROG_SUB0PUB_JOIN_HPP
+#define CROG_SUB0PUB_JOIN_HPP
+
+#include "sub0pub/sub0pub.hpp"
+
+#include <tuple> //< std::tuple
+#include <utility> //< std::index_sequence
+
+/** Match Data in a Join by a member instead of MessageInfo::timestamp
+ * @note Must be used from the global namespace
+ * @param  Data  Fully qualified Data type e.g. SUB0_JOIN_KEY(my::Pose, timestamp)
+ * @param  member  Integral member of Data converted to uint64_t as the key
+ */
+#define SUB0_JOIN_KEY(Data, member) \
+    namespace sub0 { template<> struct JoinKey<Data> { static uint64_t key( const Data& data ) { return static_cast<uint64_t>( data.member ); } }; }
+
+namespace sub0
+{
+    /** Key by which messages of 'Data' are matched in a Join, MessageInfo::timestamp of the publish by default
+     * @remark Specialise with SUB0_JOIN_KEY(Data, member) to match on a sequence, frame number or embedded timestamp
+     * @tparam Data  Data type joined
+     */
+    template< typename Data >
+    struct JoinKey
+    {
+        static uint64_t key( const Data& )
+        {
+            static_assert( HasMessageInfo<Data>::value, "Join requires SUB0_MESSAGE_INFO(Data) or SUB0_JOIN_KEY(Data, member)" );
+            return Broker<Data>::messageInfo().timestamp;
+        }
+    };
+
+    namespace detail
+    {
+        /** Subscription of one input of a Join forwarding to Target::arrive
+         */
+        template< typename Target, typename Data >
+        class JoinInput : public Subscribe<Data>
+        {
+        public:
+            void receive( const Data& data ) final
+            { static_cast<Target*>( this )->arrive( data ); }
+        };
+
+        template< typename Data, typename... Datas >
+        struct IndexOf;
+
+        template< typename Data, typename... Datas >
+        struct IndexOf<Data, Data, Datas...> : std::integral_constant<size_t, 0U> {};
+
+        template< typename Data, typename Other, typename... Datas >
+        struct IndexOf<Data, Other, Datas...> : std::integral_constant<size_t, 1U + IndexOf<Data, Datas...>::value> {};
+
+    } // END: detail
+
+    /** Subscribes to each of Datas and delivers messages with matching keys together as one receive()
+     * @remark Unmatched messages wait in a preallocated ring of cDepth per input, the oldest is dropped when full.
+     *  Keys are taken by JoinKey<Data> and expected to increase per input. With Policy::Exact or Policy::Nearest
+     *  each arrival is matched against the waiting messages of every other input, matched messages and those older
+     *  are then discarded, so each message is delivered at most once. Policy::Latest instead pairs every arrival with
+     *  the newest message of each other input, as a zip of the latest values.
+     *  e.g.
+     *  class Fusion : public sub0::Join<Pose, Image, Imu>
+     *  {
+     *      void receive( const Pose& pose, const Image& image, const Imu& imu ) override;
+     *  };
+     * @note Not thread-safe, publishes of Datas must be serialised as for any Subscribe<Data>
+     * @tparam Datas  Distinct Data types joined
+     */
+    template< typename... Datas >
+    class Join : public detail::JoinInput< Join<Datas...>, Datas >...
+    {
+        static_assert( sizeof...(Datas) >= 2U, "Join requires at least two Data types" );
+
+        template< typename Target, typename Data >
+        friend class detail::JoinInput;
+
+    public:
+        static const uint32_t cDepth = 8U; ///< Unmatched messages held per input
+
+        enum class Policy {
+              Exact ///< Keys are equal
+            , Nearest ///< Nearest key of each other input within Config::tolerance
+            , Latest ///< Newest message of each other input within Config::tolerance, messages are not consumed
+        };
+
+        struct Config
+        {
+            Policy policy = Policy::Nearest;
+            uint64_t tolerance = 0U; ///< Largest key difference matched by Nearest and Latest, e.g. nanoseconds of MessageInfo::timestamp
+        };
+
+    public:
+        explicit Join( const Config& config = Config() )
+            : config_( config )
+            , rings_()
+            , dropCount_( 0U )
+        {}
+
+        /** Receive a matched set of messages
+         * @remark Messages are copies owned by the Join, only valid during the call
+         */
+        virtual void receive( const Datas&... datas ) = 0;
+
+        /** @return Count of messages discarded unmatched, overwritten in a full ring or older than a match
+         */
+        uint64_t dropCount() const
+        { return dropCount_; }
+
+        /** Discard all waiting messages
+         */
+        void clear()
+        { clear( std::index_sequence_for<Datas...>() ); }
+
+    private:
+        /** Ring of unmatched messages of one input, oldest first
+         */
+        template< typename Data >
+        struct Ring
+        {
+            Data entries[cDepth];
+            uint64_t keys[cDepth];
+            uint32_t first = 0U; ///< Slot of the oldest entry
+            uint32_t count = 0U;
+
+            uint32_t slot( const uint32_t index ) const
+            { return (first + index) % cDepth; }
+
+            /** Append, overwriting the oldest when full
+             * @return True if an entry was overwritten
+             */
+            bool push( const Data& data, const uint64_t key )
+            {
+                const bool isFull = (count == cDepth);
+                const uint32_t iSlot = slot( isFull ? 0U : count );
+                entries[iSlot] = data;
+                keys[iSlot] = key;
+                if ( isFull )
+                    first = slot( 1U );
+                else
+                    ++count;
+                return isFull;
+            }
+
+            /** Discard entries up to and including 'index'
+             */
+            void dropThrough( const uint32_t index )
+            {
+                first = slot( index + 1U );
+                count -= index + 1U;
+            }
+
+            /** @return Index of the entry matching 'key' by 'policy', cDepth if none
+             */
+            uint32_t find( const uint64_t key, const Config& config ) const
+            {
+                if ( config.policy == Policy::Latest )
+                    return (count != 0U && distance( keys[slot( count - 1U )], key ) <= config.tolerance) ? count - 1U : cDepth;
+
+                uint32_t best = cDepth;
+                uint64_t bestDistance = (config.policy == Policy::Exact) ? 0U : config.tolerance;
+                for ( uint32_t index = 0U; index < count; ++index )
+                {
+                    const uint64_t entryDistance = distance( keys[slot( index )], key );
+                    if ( entryDistance <= bestDistance )
+                    {
+                        best = index;
+                        bestDistance = entryDistance;
+                    }
+                }
+                return best;
+            }
+
+            static uint64_t distance( const uint64_t lhs, const uint64_t rhs )
+            { return (lhs > rhs) ? lhs - rhs : rhs - lhs; }
+        };
+
+        template< typename Data >
+        void arrive( const Data& data )
+        { arrive<detail::IndexOf<Data, Datas...>::value>( data, std::index_sequence_for<Datas...>() ); }
+
+        /** Match an arrival on input cInput against the other inputs, deliver or wait
+         */
+        template< size_t cInput, typename Data, size_t... cIndices >
+        void arrive( const Data& data, std::index_sequence<cIndices...> )
+        {
+            const uint64_t key = JoinKey<Data>::key( data );
+            const uint32_t matches[] = { ((cIndices == cInput) ? 0U : std::get<cIndices>( rings_ ).find( key, config_ ))... };
+            bool isMatched = true;
+            for ( size_t iInput = 0U; iInput < sizeof...(Datas); ++iInput )
+                isMatched = isMatched && (matches[iInput] != cDepth);
+
+            Ring<Data>& ring = std::get<cInput>( rings_ );
+            if ( !isMatched || config_.policy == Policy::Latest )
+            {
+                if ( config_.policy == Policy::Latest )
+                    ring.first = ring.count = 0U; //< Only the newest is kept
+                dropCount_ += ring.push( data, key ) ? 1U : 0U;
+                if ( !isMatched )
+                    return;
+            }
+
+            // Copy out the matched set so a publish from receive() may refill the rings
+            const std::tuple<Datas...> matched( entry<cIndices, cInput>( data, matches[cIndices] )... );
+            if ( config_.policy != Policy::Latest )
+            {
+                int expand[] = { (consume<cIndices, cInput>( matches[cIndices], key ), 0)... };
+                (void)expand;
+            }
+            receive( std::get<cIndices>( matched )... );
+        }
+
+        /** @return Message of input cIndex in the matched set
+         */
+        template< size_t cIndex, size_t cInput, typename Data >
+        const typename std::tuple_element<cIndex, std::tuple<Datas...> >::type& entry( const Data& data, const uint32_t index ) const
+        {
+            if constexpr ( cIndex == cInput )
+                return data;
+            else
+            {
+                const auto& ring = std::get<cIndex>( rings_ );
+                return ring.entries[ring.slot( index )];
+            }
+        }
+
+        /** Discard the matched entry of input cIndex and those before it, and stale entries of the arriving input
+         */
+        template< size_t cIndex, size_t cInput >
+        void consume( const uint32_t index, const uint64_t key )
+        {
+            auto& ring = std::get<cIndex>( rings_ );
+            uint32_t count = (cIndex == cInput) ? 0U : index + 1U;
+            if constexpr ( cIndex == cInput )
+            {
+                while ( count < ring.count && ring.keys[ring.slot( count )] <= key )
+                    ++count;
+            }
+            dropCount_ += count - ((cIndex == cInput) ? 0U : 1U);
+            if ( count != 0U )
+                ring.dropThrough( count - 1U );
+        }
+
+        template< size_t... cIndices >
+        void clear( std::index_sequence<cIndices...> )
+        {
+            int expand[] = { ((std::get<cIndices>( rings_ ).count = 0U), 0)... };
+            (void)expand;
+        }
+
+    private:
+        Config config_;
+        std::tuple< Ring<Datas>... > rings_;
+        uint64_t dropCount_;
+    };
+
+} // END: sub0
+
+#endif // CROG_SUB0PUB_JOIN_HPP
@@ -0,0 +1,114 @@
+/** Sub0Pub lock-free cache of the latest published Data for polling readers
+ * @remark Opt-in extension of sub0pub.hpp
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#ifndef CROG_SUB0PUB_LASTVALUE_HPP
+#define CROG_SUB0PUB_LASTVALUE_HPP
+
+#include "sub0pub/sub0pub.hpp"
+
+#include <atomic> //< std::atomic
+#include <type_traits> //< std::is_trivially_copyable
+
+namespace sub0
+{
+    /** Latest Data published to Broker<Data>, read at the consumer's own rate instead of through receive()
+     * @remark Subscribes as any Subscribe<Data> so is updated as part of publish(). The value is held behind a seqlock:
+     *  publish() never waits for readers, and read() from any thread retries until it copies a value no publish
+     *  overlapped. The payload is stored as relaxed atomic words so concurrent access is race-free, a read costs two
+     *  loads of the sequence plus a copy of Data.
+     *  e.g. A render thread at 60 Hz taking the latest pose of a 1 kHz publisher
+     * @note Construct and destroy from the publishing thread as for Subscribe<Data>
+     * @tparam Data  Trivially copyable Data type to cache
+     */
+    template< typename Data >
+    class LastValue : public Subscribe<Data>
+    {
+        static_assert( std::is_trivially_copyable<Data>::value, "LastValue<Data> requires trivially copyable Data" );
+
+    public:
+        /** Subscribe with no value, read() fails until the next publish
+         * @remark Call Subscribe<Data>::replay() to start from a value retained by SUB0_HISTORY
+         */
+        LastValue()
+            : sequence_( 0U )
+            , words_()
+        {}
+
+        /** Take a consistent copy of the latest value
+         * @param[out] data  Latest published Data, unchanged if none
+         * @return False if nothing was published since construction
+         */
+        bool read( Data& data ) const
+        {
+            return read( data, nullptr );
+        }
+
+        /** Take a consistent copy of the latest value and its version
+         * @param[out] data  Latest published Data, unchanged if none
+         * @param[out] version  Count of publishes received when the copy was taken, may be nullptr
+         *  e.g. Compare to a previous version to detect a new value
+         * @return False if nothing was published since construction
+         */
+        bool read( Data& data, uint64_t* const version ) const
+        {
+            uint64_t words[cWordCount];
+            uint64_t begin = sequence_.load( std::memory_order_acquire );
+            for ( ;; )
+            {
+                if ( (begin & 1U) == 0U )
+                {
+                    for ( size_t iWord = 0U; iWord < cWordCount; ++iWord )
+                        words[iWord] = words_[iWord].load( std::memory_order_relaxed );
+                    std::atomic_thread_fence( std::memory_order_acquire );
+                    const uint64_t end = sequence_.load( std::memory_order_relaxed );
+                    if ( end == begin )
+                        break;
+                    begin = end;
+                }
+                else
+                    begin = sequence_.load( std::memory_order_acquire ); //< Publish in progress
+            }
+
+            if ( version != nullptr )
+                *version = begin / 2U;
+            if ( begin == 0U )
+                return false;
+            std::memcpy( &data, words, sizeof(Data) );
+            return true;
+        }
+
+        /** @return Count of publishes received, changes whenever a new value is available
+         */
+        uint64_t version() const
+        { return sequence_.load( std::memory_order_acquire ) / 2U; }
+
+        /** Store published Data
+         * @remark Single writer, publishes of Data from several threads must be serialised as for any Subscribe<Data>
+         */
+        void receive( const Data& data ) override
+        {
+            uint64_t words[cWordCount];
+            words[cWordCount - 1U] = 0U; //< Padding past sizeof(Data)
+            std::memcpy( words, &data, sizeof(Data) );
+
+            const uint64_t sequence = sequence_.load( std::memory_order_relaxed );
+            sequence_.store( sequence + 1U, std::memory_order_relaxed );
+            std::atomic_thread_fence( std::memory_order_release ); //< Odd sequence visible before any word
+
+            for ( size_t iWord = 0U; iWord < cWordCount; ++iWord )
+                words_[iWord].store( words[iWord], std::memory_order_relaxed );
+            sequence_.store( sequence + 2U, std::memory_order_release );
+        }
+
+    private:
+        static const size_t cWordCount = (sizeof(Data) + sizeof(uint64_t) - 1U) / sizeof(uint64_t);
+
+        alignas(64) std::atomic<uint64_t> sequence_; ///< Odd while a publish is storing, twice the count of publishes
+        std::atomic<uint64_t> words_[cWordCount]; ///< Data as words, copied out by read()
+    };
+
+} // END: sub0
+
+#endif // CROG_SUB0PUB_LASTVALUE_HPP
@@ -0,0 +1,400 @@
+/** Sub0Pub k-way timestamp merge of multiple input streams
+ * @remark Opt-in extension of sub0pub.hpp
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#ifndef CROG_SUB0PUB_MERGE_HPP
+#define CROG_SUB0PUB_MERGE_HPP
+
+#include "sub0pub/sub0pub.hpp"
+
+#include <cstddef> //< std::max_align_t
+#include <memory> //< std::unique_ptr
+#include <vector> //< std::vector
+
+namespace sub0
+{
+    /** Check for `Data::timestamp` member for SFINAE
+    */
+    template<typename Data>
+    using timestamp_member_t = decltype( std::declval<const Data&>().timestamp );
+
+    /** Publishes messages from multiple serialised-input streams interleaved in timestamp order
+     * @remark Each input is read by its own StreamDeserializer into a bounded look-ahead queue, the input with the
+     *  earliest queued timestamp is selected by a min-heap and its frame published. Inputs are expected to be
+     *  individually in timestamp order e.g. One recording per process.
+     * @remark Data types are registered exactly as for StreamDeserializer i.e. via ForwardPublish<Data,Derived>.
+     *  The timestamp of a Data is read from a `timestamp` member when present or may be set by setTimestamp(),
+     *  otherwise MessageInfo::timestamp decoded by the Protocol is used e.g. MessageInfoSerialisation.
+     *  Data types without a timestamp are published as soon as they reach the head of their input queue.
+     *  MessageInfo decoded by the Protocol is forwarded to subscribers.
+     * @note An input returning false from StreamDeserializer::update() is considered exhausted i.e. End of recording
+     *
+     * @tparam  Protocol  Stream data protocol to use defining how the data header and payload is structured
+     */
+    template< typename Protocol = DefaultSerialisation, typename ProtocolReader = typename Protocol::Reader >
+    class MergeDeserializer
+    {
+    public:
+        typedef uint64_t Timestamp;
+
+        struct Config
+        {
+            uint_fast16_t lookahead = 1U; ///< Frames buffered per input, >1 reads ahead to amortise stream access
+        };
+
+    public:
+        MergeDeserializer()
+            : config_()
+            , registrations_()
+            , inputs_()
+            , heap_()
+            , current_(cNoInput)
+        {}
+
+        bool configure( const Config& config )
+        {
+#if SUB0PUB_ASSERT
+            assert( inputs_.empty() ); /// @todo We don't intend to support reconfiguring once inputs are added
+            assert( config.lookahead > 0U );
+#endif
+            config_ = config;
+            return true;
+        }
+
+        /** Register Data publisher for frames of all inputs
+         * @remark Called by sub0::ForwardPublish<Data>
+         */
+        template < typename Data >
+        void setDataPublisher( Data& dataBuffer, IPublish& publisher )
+        {
+#if SUB0PUB_ASSERT
+            assert( inputs_.empty() ); /// @todo We don't intend to support adding buffers once inputs are added
+            assert( alignof(Data) <= alignof(std::max_align_t) );
+#endif
+            registrations_.push_back( Registration{
+                  &typeKey<Data>
+                , reinterpret_cast<char*>(&dataBuffer)
+                , sizeof(Data)
+                , &publisher
+                , &Registration::template attach<Data>
+                , nullptr
+                , nullptr } );
+            setTimestamp<Data>( timestampMember<Data>() );
+        }
+
+        /** Set function reading the timestamp of Data
+         * @param timestamp  Function returning timestamp of a Data, nullptr for Data published without ordering
+         */
+        template < typename Data >
+        void setTimestamp( Timestamp (*timestamp)( const Data& data ) )
+        {
+            Registration* const registration = find( &typeKey<Data> );
+#if SUB0PUB_ASSERT
+            assert( registration ); //< setDataPublisher<Data>() must be called first
+#endif
+            registration->timestamp = reinterpret_cast<void(*)()>( timestamp );
+            registration->invokeTimestamp = timestamp ? &Registration::template invoke<Data> : nullptr;
+        }
+
+        /** Add an input stream to be merged
+         * @param[in] istream  Stream from which data is de-serialized @warning Must remain valid until close()
+         * @return Reference to the input deserializer e.g. For configure()
+         */
+        StreamDeserializer<Protocol, ProtocolReader>& addInput( IStream& istream )
+        {
+            inputs_.emplace_back( new Input( *this, istream ) );
+            return *inputs_.back();
+        }
+
+        /** Prime reader state of all inputs and read the first frame of each
+        */
+        bool open()
+        {
+            bool opened = true;
+            heap_.clear();
+            current_ = cNoInput;
+            for ( uint_fast16_t iInput = 0U; iInput < inputs_.size(); ++iInput )
+            {
+                Input& input = *inputs_[iInput];
+                opened &= input.open();
+                input.refill();
+                if ( !input.empty() )
+                    pushHeap( iInput );
+            }
+            return opened;
+        }
+
+        /** Publish the next frame in timestamp order across all inputs
+         * @return True when a frame was published, false once all inputs are exhausted
+         */
+        bool update()
+        {
+            if ( current_ == cNoInput )
+            {
+                if ( heap_.empty() )
+                    return false;
+                current_ = popHeap();
+            }
+
+            Input& input = *inputs_[current_];
+            input.publishFront();
+            input.refill();
+
+            // Continue from the same input without heap operations while it remains earliest
+            if ( input.empty() )
+                current_ = cNoInput;
+            else if ( !heap_.empty() && heap_.front() < headOf(current_) )
+            {
+                pushHeap( current_ );
+                current_ = cNoInput;
+            }
+            return true;
+        }
+
+        /** Reset reader state of all inputs
+        */
+        bool close()
+        {
+            bool closed = true;
+            for ( std::unique_ptr<Input>& input : inputs_ )
+                closed &= input->close();
+            inputs_.clear();
+            heap_.clear();
+            current_ = cNoInput;
+            return closed;
+        }
+
+    private:
+        static constexpr uint_fast16_t cNoInput = ~uint_fast16_t(0U);
+
+        /** Unique address per Data type
+        */
+        template< typename Data >
+        static constexpr char typeKey = 0;
+
+        /** Type-erased Data registration
+        */
+        struct Registration
+        {
+            const char* key; ///< typeKey<Data>
+            char* buffer; ///< Destination buffer of the registered publisher
+            size_t size; ///< sizeof(Data)
+            IPublish* publisher; ///< Registered publisher
+            void (*attachInput)( StreamDeserializer<Protocol, ProtocolReader>& input, char* staging, IPublish& publisher );
+            void (*timestamp)(); ///< Erased `Timestamp(*)(const Data&)`, nullptr when Data is unordered
+            Timestamp (*invokeTimestamp)( void (*timestamp)(), const char* data );
+
+            template< typename Data >
+            static void attach( StreamDeserializer<Protocol, ProtocolReader>& input, char* staging, IPublish& publisher )
+            { input.setDataPublisher( *reinterpret_cast<Data*>(staging), publisher ); }
+
+            template< typename Data >
+            static Timestamp invoke( void (*timestamp)(), const char* data )
+            { return reinterpret_cast<Timestamp(*)(const Data&)>(timestamp)( *reinterpret_cast<const Data*>(data) ); }
+
+            Timestamp timestampOf( const char* const data ) const
+            { return invokeTimestamp ? invokeTimestamp( timestamp, data ) : Timestamp(0U); }
+        };
+
+        template< typename Data >
+        static Timestamp readTimestampMember( const Data& data )
+        { return static_cast<Timestamp>( data.timestamp ); }
+
+        template< typename Data >
+        static Timestamp (*timestampMember())( const Data& )
+        {
+            if constexpr ( utility::is_detected<timestamp_member_t, Data>::value )
+                return &readTimestampMember<Data>;
+            else
+                return nullptr;
+        }
+
+        Registration* find( const char* const key )
+        {
+            for ( Registration& registration : registrations_ )
+            {
+                if ( registration.key == key )
+                    return &registration;
+            }
+            return nullptr;
+        }
+
+        /** Input stream with bounded queue of decoded frames
+        */
+        class Input : public StreamDeserializer<Protocol, ProtocolReader>
+        {
+        public:
+            Input( MergeDeserializer& owner, IStream& istream )
+                : StreamDeserializer<Protocol, ProtocolReader>( istream )
+                , owner_(owner)
+                , taps_()
+                , frames_( owner.config_.lookahead )
+                , frameBytes_(0U)
+                , storage_()
+                , head_(0U)
+                , count_(0U)
+                , exhausted_(false)
+            {
+                for ( const Registration& registration : owner_.registrations_ )
+                    frameBytes_ = std::max( frameBytes_, roundUp( registration.size ) );
+                storage_.reset( new std::max_align_t[ (frames_.size() * frameBytes_) / sizeof(std::max_align_t) ] );
+
+                taps_.reserve( owner_.registrations_.size() );
+                for ( uint_fast16_t iRegistration = 0U; iRegistration < owner_.registrations_.size(); ++iRegistration )
+                {
+                    const Registration& registration = owner_.registrations_[iRegistration];
+                    taps_.emplace_back( new Tap( *this, iRegistration, roundUp( registration.size ) ) );
+                    registration.attachInput( *this, taps_.back()->staging(), *taps_.back() );
+                }
+            }
+
+            /** Prime reader state and clear queued frames
+            */
+            bool open()
+            {
+                head_ = 0U;
+                count_ = 0U;
+                exhausted_ = false;
+                return StreamDeserializer<Protocol, ProtocolReader>::open();
+            }
+
+            bool empty() const
+            { return count_ == 0U; }
+
+            /** @return Timestamp of the earliest queued frame
+            */
+            Timestamp frontTimestamp() const
+            { return frames_[head_].timestamp; }
+
+            /** Read from the stream until the queue is full or the stream is exhausted
+            */
+            void refill()
+            {
+                while ( !exhausted_ && count_ < frames_.size() )
+                    exhausted_ = !this->update();
+            }
+
+            /** Publish the earliest queued frame
+            */
+            void publishFront()
+            {
+                const Frame& frame = frames_[head_];
+                const Registration& registration = owner_.registrations_[frame.registration];
+                const MessageInfo info = frame.info;
+                std::memcpy( registration.buffer, frameData(head_), registration.size );
+
+                head_ = (head_ + 1U) % frames_.size();
+                --count_;
+                if ( info.sequence != 0U )
+                    registration.publisher->publish( info );
+                else
+                    registration.publisher->publish();
+            }
+
+        private:
+            struct Frame
+            {
+                Timestamp timestamp;
+                uint_fast16_t registration; ///< Index into MergeDeserializer::registrations_
+                MessageInfo info; ///< Metadata decoded with the frame
+            };
+
+            /** Receives completed frames of a registered Data type from the input stream into the queue
+            */
+            class Tap : public IPublish
+            {
+            public:
+                Tap( Input& input, const uint_fast16_t registration, const size_t size )
+                    : input_(input)
+                    , registration_(registration)
+                    , staging_( new std::max_align_t[ size / sizeof(std::max_align_t) ] )
+                {}
+
+                char* staging()
+                { return reinterpret_cast<char*>( staging_.get() ); }
+
+                void publish() override
+                { input_.push( registration_, staging(), MessageInfo() ); }
+
+                void publish( const MessageInfo& info ) override
+                { input_.push( registration_, staging(), info ); }
+
+            private:
+                Input& input_;
+                const uint_fast16_t registration_;
+                std::unique_ptr<std::max_align_t[]> staging_; ///< Buffer the input stream de-serialises Data into
+            };
+
+            static size_t roundUp( const size_t size )
+            { return ((size + sizeof(std::max_align_t) - 1U) / sizeof(std::max_align_t)) * sizeof(std::max_align_t); }
+
+            char* frameData( const size_t iFrame )
+            { return reinterpret_cast<char*>( storage_.get() ) + iFrame * frameBytes_; }
+
+            void push( const uint_fast16_t iRegistration, const char* const data, const MessageInfo& info )
+            {
+#if SUB0PUB_ASSERT
+                assert( count_ < frames_.size() ); //< refill() reads at most one frame per update()
+#endif
+                const Registration& registration = owner_.registrations_[iRegistration];
+                const size_t iFrame = (head_ + count_) % frames_.size();
+                std::memcpy( frameData(iFrame), data, registration.size );
+                const Timestamp timestamp = registration.invokeTimestamp ? registration.timestampOf(data) : info.timestamp;
+                frames_[iFrame] = Frame{ timestamp, iRegistration, info };
+                ++count_;
+            }
+
+        private:
+            MergeDeserializer& owner_;
+            std::vector< std::unique_ptr<Tap> > taps_; ///< Per registration receiver of the input stream
+            std::vector<Frame> frames_; ///< Queue of frames as ring buffer
+            size_t frameBytes_; ///< Storage stride per queued frame
+            std::unique_ptr<std::max_align_t[]> storage_; ///< Data of queued frames
+            size_t head_; ///< Index of earliest frame in frames_
+            size_t count_; ///< Count of queued frames
+            bool exhausted_; ///< Stream has no further data
+        };
+
+        /** Earliest queued frame of an input
+         * @note Timestamp is cached to avoid indirection to the input during heap operations
+        */
+        struct Head
+        {
+            Timestamp timestamp;
+            uint_fast16_t input;
+
+            /** Order by timestamp then input index for stable merge of equal timestamps
+            */
+            bool operator < ( const Head& rhs ) const
+            { return (timestamp < rhs.timestamp) || ((timestamp == rhs.timestamp) && (input < rhs.input)); }
+        };
+
+        Head headOf( const uint_fast16_t iInput ) const
+        { return Head{ inputs_[iInput]->frontTimestamp(), iInput }; }
+
+        void pushHeap( const uint_fast16_t iInput )
+        {
+            heap_.push_back( headOf(iInput) );
+            std::push_heap( heap_.begin(), heap_.end(), []( const Head& lhs, const Head& rhs ) { return rhs < lhs; } );
+        }
+
+        uint_fast16_t popHeap()
+        {
+            std::pop_heap( heap_.begin(), heap_.end(), []( const Head& lhs, const Head& rhs ) { return rhs < lhs; } );
+            const uint_fast16_t iInput = heap_.back().input;
+            heap_.pop_back();
+            return iInput;
+        }
+
+    private:
+        Config config_;
+        std::vector<Registration> registrations_;
+        std::vector< std::unique_ptr<Input> > inputs_;
+        std::vector<Head> heap_; ///< Min-heap of inputs with queued frames, excluding current_
+        uint_fast16_t current_; ///< Input being published from, earlier than all heap_ inputs
+    };
+
+} // END: sub0
+
+#endif
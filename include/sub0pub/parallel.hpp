@@ -0,0 +1,536 @@
+/** Sub0Pub parallel decoding of segmented recordings
+ * @remark Opt-in extension of sub0pub.hpp requiring std::thread support
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#ifndef CROG_SUB0PUB_PARALLEL_HPP
+#define CROG_SUB0PUB_PARALLEL_HPP
+
+#include "sub0pub/sub0pub.hpp"
+#include "sub0pub/compression.hpp"
+
+#include <atomic> //< std::atomic
+#include <condition_variable> //< std::condition_variable
+#include <mutex> //< std::mutex
+#include <thread> //< std::thread
+#include <vector> //< std::vector
+
+namespace sub0
+{
+    /** Locates frames of a binary protocol, as written by BinaryWriter, within a contiguous memory block
+     * @remark Payload sizes are resolved from the BufferRegister in the same manner as BinaryReader
+     * @tparam  Protocol  Binary protocol defining Prefix, Header and Postfix types @see sub0::DefaultSerialisation
+     * @tparam  BufferRegister  Registry of Data buffers keyed by Protocol::Header
+     */
+    template< typename Protocol = DefaultSerialisation, typename BufferRegister = sub0::BufferRegister<typename Protocol::Header> >
+    class BinaryFrameParser
+    {
+    public:
+        typedef typename Protocol::Prefix Prefix_t;
+        typedef typename Protocol::Header Header_t;
+        typedef typename Protocol::Postfix Postfix_t;
+
+        static constexpr size_t cPrefixSize = utility::sizeOf<Prefix_t>();
+        static constexpr size_t cHeaderSize = sizeof(Header_t);
+        static constexpr size_t cPostfixSize = utility::sizeOf<Postfix_t>();
+
+        enum class Status {
+              Complete ///< Frame parsed and validated
+            , Incomplete ///< Memory block ends before the frame
+            , SyncLost ///< Delimiter, header or registration mismatch i.e. Corrupted or misaligned input
+        };
+
+        /** Frame located within a memory block
+        */
+        struct Frame
+        {
+            Buffer target; ///< Registered buffer and publisher of the payload Data
+            const char* payload; ///< Payload bytes within the parsed memory block
+            uint_least16_t payloadSize; ///< Count of payload bytes copied into target.buffer
+            size_t frameSize; ///< Total bytes of the frame including delimiters and padding
+        };
+
+        /** Parse and validate the frame starting at 'data'
+         * @param[in] registry  Registered Data buffers used to resolve the payload size from the header
+         * @param[in] data  First byte of the frame i.e. Prefix
+         * @param[in] size  Count of bytes available from 'data'
+         * @param[out] frame  Located frame, valid only when Status::Complete is returned
+         * @return Status::Complete when frame is valid
+         */
+        static Status parse( BufferRegister& registry, const char* const data, const size_t size, Frame& frame )
+        {
+            if ( size < cPrefixSize + cHeaderSize )
+                return Status::Incomplete;
+
+            if ( !matches<Prefix_t>(data) )
+                return Status::SyncLost;
+
+            Header_t header;
+            std::memcpy( reinterpret_cast<char*>(&header), data + cPrefixSize, cHeaderSize );
+            if ( !registry.validate(header) )
+                return Status::SyncLost;
+
+            frame.target = registry.find(header);
+            if ( frame.target.buffer == nullptr )
+                return Status::SyncLost;
+
+            const size_t wireSize = static_cast<size_t>( frame.target.bufferSize + frame.target.paddingSize ); ///< @note Negative padding is not present on the wire
+            frame.payload = data + cPrefixSize + cHeaderSize;
+            frame.payloadSize = static_cast<uint_least16_t>( std::min<size_t>( frame.target.bufferSize, wireSize ) );
+            frame.frameSize = cPrefixSize + cHeaderSize + wireSize + cPostfixSize;
+
+            if ( size < frame.frameSize )
+                return Status::Incomplete;
+
+            return matches<Postfix_t>( frame.payload + wireSize ) ? Status::Complete : Status::SyncLost;
+        }
+
+        /** Copy payload into the registered buffer and signal the publisher
+         * @param frame  Frame located by parse()
+         */
+        static void publish( const Frame& frame )
+        {
+            std::memcpy( frame.target.buffer, frame.payload, frame.payloadSize );
+            frame.target.publisher->publish();
+        }
+
+        /** Find the first frame boundary at or after 'offset'
+         * @remark When Prefix_t is defined the block is scanned for a prefix from which two consecutive frames validate,
+         *         otherwise frames are walked from 'from' which must itself be a frame boundary.
+         * @warning Scanning relies on the Prefix delimiter not being aliased in payload data, supply an index of
+         *          segment boundaries where the recording provides one
+         * @param[in] from  Known frame boundary preceding 'offset'
+         * @return Offset of the boundary, 'size' if none exists
+         */
+        static size_t findBoundary( BufferRegister& registry, const char* const data, const size_t size, const size_t from, const size_t offset )
+        {
+            Frame frame;
+            if ( std::is_void<Prefix_t>::value )
+            {
+                size_t boundary = from;
+                while ( boundary < offset && parse( registry, data + boundary, size - boundary, frame ) == Status::Complete )
+                    boundary += frame.frameSize;
+                return std::min( boundary, size ); ///< @note Truncated or corrupt tail forms part of the last segment
+            }
+
+            for ( size_t boundary = offset; boundary < size; ++boundary )
+            {
+                if ( parse( registry, data + boundary, size - boundary, frame ) != Status::Complete )
+                    continue;
+
+                const size_t next = boundary + frame.frameSize;
+                if ( next == size || parse( registry, data + next, size - next, frame ) != Status::SyncLost )
+                    return boundary;
+            }
+            return size;
+        }
+
+    private:
+        /** Compare delimiter bytes against default constructed delimiter value
+         */
+        template< typename Delimiter_t >
+        static typename std::enable_if< !std::is_void<Delimiter_t>::value, bool >::type matches( const char* const data )
+        {
+            typename std::aligned_storage< sizeof(Delimiter_t), alignof(Delimiter_t) >::type storage;
+            std::memcpy( &storage, data, sizeof(Delimiter_t) );
+            return *reinterpret_cast<const Delimiter_t*>(&storage) == Delimiter_t();
+        }
+
+        template< typename Delimiter_t >
+        static typename std::enable_if< std::is_void<Delimiter_t>::value, bool >::type matches( const char* const )
+        { return true; }
+    };
+
+    /** Publishes messages from an in-memory recording by decoding segments of it on a pool of worker threads
+     * @remark The recording is expected to be generated by a StreamSerializer for the same Protocol e.g. a memory-mapped file
+     * @remark Data types are registered exactly as for StreamDeserializer i.e. via ForwardPublish<Data,Derived>
+     *
+     * Delivery::Ordered
+     *     Workers validate and index frames of segments while the thread calling update() publishes them in recording
+     *     order. At most Config::reorderWindow decoded segments are held pending publish, bounding memory use.
+     *     Subscribers receive data on the update() thread only and need not be thread-safe.
+     *
+     * Delivery::UnorderedPerType
+     *     Workers publish directly as segments are decoded. Publishes of a Data type are serialised against each other
+     *     but are not in recording order, and different Data types are received concurrently. Subscribers must be thread-safe.
+     *
+     * @remark Block compressed protocols e.g. CompressedSerialisation<> are segmented on block boundaries, each worker
+     *  decompresses its own blocks before indexing their frames
+     * @note Protocols carrying state between frames e.g. MessageInfoSerialisation cannot be decoded from arbitrary segments
+     * @tparam  Protocol  Binary protocol defining Prefix, Header and Postfix types @see sub0::DefaultSerialisation
+     */
+    template< typename Protocol = DefaultSerialisation, typename FrameParser = BinaryFrameParser<Protocol> >
+    class ParallelDeserializer
+    {
+    public:
+        typedef typename FrameParser::Header_t Header_t;
+        typedef typename FrameParser::Frame Frame;
+        typedef sub0::BufferRegister<Header_t> BufferRegister;
+
+        enum class Delivery {
+              Ordered ///< Publish in recording order from the update() thread
+            , UnorderedPerType ///< Publish from worker threads, serialised per Data type only
+        };
+
+        struct Config
+        {
+            uint_fast16_t workerCount = 0U; ///< Count of decoding threads, 0 selects std::thread::hardware_concurrency()
+            size_t segmentBytes = 16U * 1024U * 1024U; ///< Target segment size when splitting an un-indexed recording
+            uint_fast16_t reorderWindow = 0U; ///< Decoded segments held pending in-order publish, 0 selects 2x workerCount
+            Delivery delivery = Delivery::Ordered;
+        };
+
+        /** Byte range of the recording decoded by a single worker
+         * @note Must begin on a frame boundary, or span whole blocks for block compressed protocols
+         */
+        struct Segment
+        {
+            size_t offset;
+            size_t size;
+        };
+
+    public:
+        /** Store reference to the recording memory which will be decoded on update()
+         * @param[in] data  Recording memory @warning Must remain valid until close()
+         * @param[in] size  Count of bytes in the recording
+         */
+        ParallelDeserializer( const char* const data, const size_t size )
+            : data_(data)
+            , size_(size)
+            , config_()
+            , registry_()
+            , segments_()
+        {}
+
+        bool configure( const Config& config )
+        {
+            config_ = config;
+            return true;
+        }
+
+        template < typename Data >
+        void setDataPublisher( Data& dataBuffer, IPublish& publisher )
+        {
+            registry_.set( dataBuffer, publisher );
+        }
+
+        /** Add a segment from a recording index
+         * @remark Where no segments are added open() splits the recording into Config::segmentBytes sized segments
+         */
+        void addSegment( const size_t offset, const size_t size )
+        {
+#if SUB0PUB_ASSERT
+            assert( offset + size <= size_ );
+#endif
+            segments_.push_back( Segment{offset, size} );
+        }
+
+        /** Split the recording into segments on frame boundaries, or block boundaries for block compressed protocols
+         * @return True if there is data to be decoded
+         */
+        bool open()
+        {
+            if constexpr ( cBlockCompressed )
+            {
+                if ( segments_.empty() )
+                {
+                    for ( size_t offset = 0U; offset < size_; )
+                    {
+                        // Block headers are walked without decompression, one segment per block
+                        BlockHeader header;
+                        size_t end = size_; ///< @note Invalid remainder is reported as Sync-Lost by update()
+                        if ( size_ - offset >= sizeof(header) )
+                        {
+                            std::memcpy( &header, data_ + offset, sizeof(header) );
+                            if ( header.isValid() && header.storedBytes <= size_ - offset - sizeof(header) )
+                                end = offset + sizeof(header) + header.storedBytes;
+                        }
+                        segments_.push_back( Segment{offset, end - offset} );
+                        offset = end;
+                    }
+                }
+            }
+            else if ( segments_.empty() )
+            {
+                const size_t segmentBytes = std::max<size_t>( config_.segmentBytes, 1U );
+                for ( size_t offset = 0U; offset < size_; )
+                {
+                    const size_t target = offset + segmentBytes;
+                    size_t end = (target < size_) ? FrameParser::findBoundary( registry_, data_, size_, offset, target ) : size_;
+                    if ( end <= offset )
+                        end = size_; ///< @note Undecodable remainder is reported as Sync-Lost by update()
+                    segments_.push_back( Segment{offset, end - offset} );
+                    offset = end;
+                }
+            }
+            return !segments_.empty();
+        }
+
+        /** Decode and publish all segments of the recording
+         * @return True when data has been published, false on error or if no data was present
+         */
+        bool update()
+        {
+            if ( segments_.empty() )
+                return false;
+
+            const uint_fast16_t workerCount = config_.workerCount ? config_.workerCount
+                : static_cast<uint_fast16_t>( std::max( std::thread::hardware_concurrency(), 1U ) );
+
+            failure_ = nullptr;
+            aborted_ = false;
+            nextSegment_ = 0U;
+            publishedSegments_ = 0U;
+
+            if ( config_.delivery == Delivery::Ordered )
+            {
+                const uint_fast16_t window = config_.reorderWindow ? config_.reorderWindow : static_cast<uint_fast16_t>(2U * workerCount);
+                slots_.resize( window );
+                for ( Slot& slot : slots_ )
+                    slot.segment = cNoSegment;
+
+                Workers workers( *this, workerCount, &ParallelDeserializer::decodeOrdered );
+                publishOrdered();
+            }
+            else
+            {
+                Workers workers( *this, workerCount - 1U, &ParallelDeserializer::decodeUnordered );
+                decodeUnordered(); //< Calling thread takes a share of the work
+            }
+
+            if ( failure_ != nullptr )
+            {
+#if __cpp_exceptions
+                throw std::runtime_error(failure_);
+#elif SUB0PUB_ASSERT
+                assert( (void*)0 == failure_ );
+#endif
+                return false;
+            }
+            return true;
+        }
+
+        /** Release segment index and decoding buffers
+        */
+        bool close()
+        {
+            segments_.clear();
+            slots_.clear();
+            return true;
+        }
+
+        /** @return Segments the recording is decoded as
+        */
+        const std::vector<Segment>& segments() const
+        { return segments_; }
+
+    private:
+        template<typename Protocol_t>
+        using block_header_t = typename Protocol_t::BlockHeader;
+
+        /// Protocol batches frames into compressed blocks @see sub0::CompressedSerialisation
+        static constexpr bool cBlockCompressed = utility::is_detected<block_header_t, Protocol>::value;
+
+        static constexpr size_t cNoSegment = ~size_t(0U);
+        static constexpr size_t cTypeLockCount = 32U; ///< Lock striping for per-type serialisation of UnorderedPerType
+
+        /** Decoded segment pending in-order publish
+        */
+        struct Slot
+        {
+            size_t segment; ///< Index of segment held, cNoSegment when empty
+            bool valid; ///< False when decoding the segment lost sync
+            std::vector<Frame> frames; ///< @note Capacity is retained between segments
+            std::vector<char> blocks; ///< Decompressed blocks of the segment referenced by frames
+        };
+
+        /** Threads running a decode function, joined on destruction
+         * @note Aborts remaining work when unwinding before completion
+        */
+        class Workers
+        {
+        public:
+            Workers( ParallelDeserializer& owner, const uint_fast16_t count, void (ParallelDeserializer::*decode)() )
+                : owner_(owner)
+            {
+                threads_.reserve(count);
+                for ( uint_fast16_t iThread = 0U; iThread < count; ++iThread )
+                    threads_.emplace_back( decode, &owner );
+            }
+
+            ~Workers()
+            {
+                owner_.abort( nullptr );
+                for ( std::thread& thread : threads_ )
+                    thread.join();
+            }
+
+        private:
+            ParallelDeserializer& owner_;
+            std::vector<std::thread> threads_;
+        };
+
+        /** Decompress all blocks of a segment
+         * @param blocks  Output decompressed content of the blocks, the content is replaced
+         * @return False when a block fails validation
+        */
+        bool decompress( const Segment& segment, std::vector<char>& blocks )
+        {
+            const char* const data = data_ + segment.offset;
+            size_t rawBytes = 0U;
+            for ( size_t offset = 0U; offset < segment.size; )
+            {
+                BlockHeader header;
+                if ( segment.size - offset < sizeof(header) )
+                    return false;
+                std::memcpy( &header, data + offset, sizeof(header) );
+                if ( !header.isValid() || header.storedBytes > segment.size - offset - sizeof(header) )
+                    return false;
+                rawBytes += header.rawBytes;
+                offset += sizeof(header) + header.storedBytes;
+            }
+
+            blocks.resize( rawBytes );
+            char* raw = blocks.data();
+            for ( size_t offset = 0U; offset < segment.size; )
+            {
+                BlockHeader header;
+                std::memcpy( &header, data + offset, sizeof(header) );
+                const char* const stored = data + offset + sizeof(header);
+                if ( header.storedBytes == header.rawBytes )
+                    std::memcpy( raw, stored, header.rawBytes );
+                else if ( !lz::decompress( stored, header.storedBytes, raw, header.rawBytes ) )
+                    return false;
+                raw += header.rawBytes;
+                offset += sizeof(header) + header.storedBytes;
+            }
+            return true;
+        }
+
+        /** Index frames of a segment
+         * @param frames  Output frames, the content is replaced
+         * @param blocks  Storage of decompressed blocks referenced by frames
+         * @return False when a frame fails validation
+        */
+        bool decode( Segment segment, std::vector<Frame>& frames, std::vector<char>& blocks )
+        {
+            frames.clear();
+            const char* data = data_ + segment.offset;
+            if constexpr ( cBlockCompressed )
+            {
+                if ( !decompress( segment, blocks ) )
+                    return false;
+                data = blocks.data();
+                segment.size = blocks.size();
+            }
+
+            for ( size_t offset = 0U; offset < segment.size; )
+            {
+                Frame frame;
+                if ( FrameParser::parse( registry_, data + offset, segment.size - offset, frame ) != FrameParser::Status::Complete )
+                    return false;
+                frames.push_back( frame );
+                offset += frame.frameSize;
+            }
+            return true;
+        }
+
+        void decodeOrdered()
+        {
+            for ( size_t iSegment = nextSegment_++; iSegment < segments_.size(); iSegment = nextSegment_++ )
+            {
+                Slot& slot = slots_[iSegment % slots_.size()];
+                {
+                    std::unique_lock<std::mutex> lock( mutex_ );
+                    condition_.wait( lock, [&]{ return aborted_ || iSegment < publishedSegments_ + slots_.size(); } );
+                    if ( aborted_ )
+                        return;
+                }
+
+                const bool valid = decode( segments_[iSegment], slot.frames, slot.blocks );
+                {
+                    std::lock_guard<std::mutex> lock( mutex_ );
+                    slot.valid = valid;
+                    slot.segment = iSegment;
+                }
+                condition_.notify_all();
+            }
+        }
+
+        void publishOrdered()
+        {
+            for ( size_t iSegment = 0U; iSegment < segments_.size(); ++iSegment )
+            {
+                Slot& slot = slots_[iSegment % slots_.size()];
+                {
+                    std::unique_lock<std::mutex> lock( mutex_ );
+                    condition_.wait( lock, [&]{ return slot.segment == iSegment; } );
+                }
+
+                if ( !slot.valid )
+                    return abort( "Sub0Pub - Sync-Lost decoding recording segment, stream corruption or incompatible data-stream" );
+
+                for ( const Frame& frame : slot.frames )
+                    FrameParser::publish( frame );
+
+                {
+                    std::lock_guard<std::mutex> lock( mutex_ );
+                    slot.segment = cNoSegment;
+                    publishedSegments_ = iSegment + 1U;
+                }
+                condition_.notify_all();
+            }
+        }
+
+        void decodeUnordered()
+        {
+            std::vector<Frame> frames;
+            std::vector<char> blocks;
+            for ( size_t iSegment = nextSegment_++; iSegment < segments_.size() && !aborted_; iSegment = nextSegment_++ )
+            {
+                if ( !decode( segments_[iSegment], frames, blocks ) )
+                    return abort( "Sub0Pub - Sync-Lost decoding recording segment, stream corruption or incompatible data-stream" );
+
+                for ( const Frame& frame : frames )
+                {
+                    const size_t iLock = (reinterpret_cast<uintptr_t>(frame.target.publisher) / sizeof(void*)) % cTypeLockCount;
+                    std::lock_guard<std::mutex> lock( typeLocks_[iLock] );
+                    FrameParser::publish( frame );
+                }
+            }
+        }
+
+        /** Stop workers waiting on the reorder window
+         * @param failure  Error message reported by update(), nullptr to stop without error
+         */
+        void abort( const char* const failure )
+        {
+            {
+                std::lock_guard<std::mutex> lock( mutex_ );
+                if ( failure_ == nullptr )
+                    failure_ = failure;
+                aborted_ = true;
+            }
+            condition_.notify_all();
+        }
+
+    private:
+        const char* const data_; ///< Recording memory
+        const size_t size_; ///< Count of bytes in data_
+        Config config_;
+        BufferRegister registry_;
+        std::vector<Segment> segments_;
+        std::vector<Slot> slots_; ///< Reorder window of decoded segments for Delivery::Ordered
+
+        std::atomic<size_t> nextSegment_; ///< Next segment to be claimed by a worker
+        size_t publishedSegments_; ///< Count of segments published in order @note Guarded by mutex_
+        std::atomic<bool> aborted_;
+        const char* failure_;  ///< @note Guarded by mutex_
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::mutex typeLocks_[cTypeLockCount];
+    };
+
+} // END: sub0
+
+#endif
@@ -0,0 +1,249 @@
+/** Sub0Pub operator pipelines fused into a single subscriber
+ * @remark Opt-in extension of sub0pub.hpp
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#ifndef CROG_SUB0PUB_PIPELINE_HPP
+#define CROG_SUB0PUB_PIPELINE_HPP
+
+#include "sub0pub/sub0pub.hpp"
+
+#include <tuple> //< std::tuple
+#include <type_traits> //< std::invoke_result_t
+#include <utility> //< std::move
+
+namespace sub0
+{
+    /** Operators composed with '|' from from<In>() to to<Out>() into one Subscribe<In> publishing Out
+     * @remark Each operator is bound to the type produced by the previous one at compile time and called inline from
+     *  Subscribe<In>::receive, so intermediate values are never published and the only broker hop is the final
+     *  Publish<Out>::publish. Operators hold their state by value, a pipeline makes no allocation.
+     *  e.g.
+     *  using namespace sub0::pipeline;
+     *  auto smoothed = from<Raw>() | filter( []( const Raw& raw ) { return raw.valid; } )
+     *                              | map( []( const Raw& raw ) { return raw.value * cScale; } )
+     *                              | window<8>( []( const float* values, size_t count ) { return mean( values, count ); } )
+     *                              | to<Cooked>();
+     */
+    namespace pipeline
+    {
+        /** Chain of operators bound from In, producing Out
+         * @tparam Stages  Bound operators in order of application
+         */
+        template< typename In, typename Out, typename... Stages >
+        struct Chain
+        {
+            std::tuple<Stages...> stages;
+        };
+
+        /** Start a chain receiving Data
+         */
+        template< typename Data >
+        Chain<Data, Data> from()
+        { return Chain<Data, Data>{}; }
+
+        /** Passes values for which 'predicate(value)' is true
+         */
+        template< typename Predicate >
+        struct Filter
+        {
+            template< typename In >
+            struct Stage
+            {
+                typedef In Output;
+
+                template< typename Next >
+                void operator()( const In& value, Next&& next )
+                {
+                    if ( predicate( value ) )
+                        next( value );
+                }
+
+                Predicate predicate;
+            };
+
+            template< typename In >
+            Stage<In> bind()
+            { return Stage<In>{ std::move( predicate ) }; }
+
+            Predicate predicate;
+        };
+
+        template< typename Predicate >
+        Filter<Predicate> filter( Predicate predicate )
+        { return Filter<Predicate>{ std::move( predicate ) }; }
+
+        /** Replaces each value with 'transform(value)'
+         */
+        template< typename Transform >
+        struct Map
+        {
+            template< typename In >
+            struct Stage
+            {
+                typedef std::decay_t< std::invoke_result_t<Transform&, const In&> > Output;
+
+                template< typename Next >
+                void operator()( const In& value, Next&& next )
+                { next( transform( value ) ); }
+
+                Transform transform;
+            };
+
+            template< typename In >
+            Stage<In> bind()
+            { return Stage<In>{ std::move( transform ) }; }
+
+            Transform transform;
+        };
+
+        template< typename Transform >
+        Map<Transform> map( Transform transform )
+        { return Map<Transform>{ std::move( transform ) }; }
+
+        /** Passes every 'period'th value, starting with the 'period'th
+         */
+        struct Sample
+        {
+            template< typename In >
+            struct Stage
+            {
+                typedef In Output;
+
+                template< typename Next >
+                void operator()( const In& value, Next&& next )
+                {
+                    if ( ++count < period )
+                        return;
+                    count = 0U;
+                    next( value );
+                }
+
+                uint32_t period;
+                uint32_t count;
+            };
+
+            template< typename In >
+            Stage<In> bind()
+            { return Stage<In>{ period, 0U }; }
+
+            uint32_t period;
+        };
+
+        inline Sample sample( const uint32_t period )
+        { return Sample{ period }; }
+
+        /** Replaces each value with 'reduce(values, count)' over the latest cSize values, oldest first
+         * @remark Nothing is passed until cSize values are received, then one value per input as a sliding window.
+         *  Values are stored twice cSize apart so the window is always contiguous without copying.
+         */
+        template< size_t cSize, typename Reduce >
+        struct Window
+        {
+            static_assert( cSize != 0U, "window<N> requires N > 0" );
+
+            template< typename In >
+            struct Stage
+            {
+                typedef std::decay_t< std::invoke_result_t<Reduce&, const In*, size_t> > Output;
+
+                template< typename Next >
+                void operator()( const In& value, Next&& next )
+                {
+                    values[position] = value;
+                    values[position + cSize] = value;
+                    position = (position + 1U == cSize) ? 0U : position + 1U;
+                    if ( count < cSize && ++count < cSize )
+                        return;
+                    next( reduce( values + position, cSize ) );
+                }
+
+                Reduce reduce;
+                In values[2U * cSize] = {};
+                size_t position = 0U; ///< Slot of the next value, and of the oldest once full
+                size_t count = 0U;
+            };
+
+            template< typename In >
+            Stage<In> bind()
+            { return Stage<In>{ std::move( reduce ) }; }
+
+            Reduce reduce;
+        };
+
+        template< size_t cSize, typename Reduce >
+        Window<cSize, Reduce> window( Reduce reduce )
+        { return Window<cSize, Reduce>{ std::move( reduce ) }; }
+
+        /** End of a chain publishing Data
+         */
+        template< typename Data >
+        struct To {};
+
+        template< typename Data >
+        To<Data> to()
+        { return To<Data>{}; }
+
+        /** Subscribe<In> applying Stages in turn and publishing the result as Out
+         * @remark Built by `chain | to<Out>()`, and not copyable as the subscription is registered by address
+         */
+        template< typename In, typename Out, typename... Stages >
+        class Pipeline : public Subscribe<In>
+                       , public Publish<Out>
+        {
+            static_assert( !std::is_same<In, Out>::value, "Pipeline would receive its own publish, use a distinct Out type" );
+
+        public:
+            explicit Pipeline( std::tuple<Stages...>&& stages )
+                : stages_( std::move( stages ) )
+            {}
+
+            Pipeline( const Pipeline& ) = delete;
+            Pipeline& operator=( const Pipeline& ) = delete;
+
+            void receive( const In& value ) override
+            { apply<0U>( value ); }
+
+        private:
+            template< size_t cStage, typename Value >
+            void apply( const Value& value )
+            {
+                if constexpr ( cStage == sizeof...(Stages) )
+                {
+                    if constexpr ( std::is_same<Value, Out>::value )
+                        Publish<Out>::publish( value );
+                    else
+                        Publish<Out>::publish( Out( value ) );
+                }
+                else
+                    std::get<cStage>( stages_ )( value, [this]( const auto& output ) { apply<cStage + 1U>( output ); } );
+            }
+
+            std::tuple<Stages...> stages_;
+        };
+
+        /** Append an operator, binding it to the output type of the chain
+         */
+        template< typename In, typename Out, typename... Stages, typename Operator >
+        Chain< In, typename Operator::template Stage<Out>::Output, Stages..., typename Operator::template Stage<Out> >
+        operator|( Chain<In, Out, Stages...> chain, Operator op )
+        {
+            return { std::tuple_cat( std::move( chain.stages ), std::make_tuple( op.template bind<Out>() ) ) };
+        }
+
+        /** Complete a chain as a Pipeline subscribing to In and publishing Data
+         */
+        template< typename In, typename Out, typename... Stages, typename Data >
+        Pipeline<In, Data, Stages...> operator|( Chain<In, Out, Stages...> chain, To<Data> )
+        {
+            static_assert( std::is_convertible<Out, Data>::value, "Pipeline output must convert to the published Data" );
+            return Pipeline<In, Data, Stages...>( std::move( chain.stages ) );
+        }
+
+    } // END: pipeline
+
+    using pipeline::from;
+
+} // END: sub0
+
+#endif // CROG_SUB0PUB_PIPELINE_HPP
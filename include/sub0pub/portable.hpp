@@ -0,0 +1,447 @@
+/** Sub0Pub endian-portable serialisation
+ * @remark Opt-in extension of sub0pub.hpp encoding payloads field-by-field in a fixed wire byte order and layout
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#ifndef CROG_SUB0PUB_PORTABLE_HPP
+#define CROG_SUB0PUB_PORTABLE_HPP
+
+#include "sub0pub/sub0pub.hpp"
+
+#include <memory> //< std::unique_ptr
+#include <vector> //< std::vector
+
+/** Host byte order
+ */
+#ifndef SUB0PUB_BIG_ENDIAN
+    #if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        #define SUB0PUB_BIG_ENDIAN 1
+    #else
+        #define SUB0PUB_BIG_ENDIAN 0 ///< @note MSVC targets are little-endian
+    #endif
+#endif
+
+/** Describe the fields of Data for portable serialisation
+ * @note Must be used from the global namespace and list every field for the wire encoding to be complete
+ * @param  Data  Fully qualified Data type e.g. SUB0_FIELDS(my::Pose, &my::Pose::position, &my::Pose::heading)
+ * @param  ...  Pointers to the data members of Data
+ */
+#define SUB0_FIELDS(Data, ...) \
+    namespace sub0 { template<> struct Fields<Data> { static constexpr auto members() { return std::make_tuple(__VA_ARGS__); } }; }
+
+namespace sub0
+{
+    /** Byte order of multi-byte values
+    */
+    enum class Endian
+    {
+          Little
+        , Big
+        , Native = SUB0PUB_BIG_ENDIAN ? Big : Little ///< Byte order of the host
+    };
+
+    /** Arrangement of payload fields on the wire
+    */
+    enum class Layout
+    {
+          Native ///< Fields at their in-memory offsets i.e. sizeof(Data) including padding
+        , Packed ///< Fields consecutive without padding bytes
+    };
+
+    /** Compile-time field list of 'Data'
+     * @remark Describe a type with SUB0_FIELDS(Data, &Data::field, ...), members() returns a tuple of member pointers.
+     *  Fields may be arithmetic or enum types, arrays of those, or types described by their own Fields.
+     * @tparam Data  Data type being described
+     */
+    template< typename Data >
+    struct Fields {};
+
+    /** Field-by-field encoding helpers
+    */
+    namespace portable
+    {
+        template< typename Data >
+        using members_t = decltype( Fields<Data>::members() );
+
+        /** Data has a field list
+        */
+        template< typename Data >
+        constexpr bool hasFields = utility::is_detected<members_t, Data>::value;
+
+        template< typename Type_t >
+        constexpr bool isScalar = std::is_arithmetic<Type_t>::value || std::is_enum<Type_t>::value;
+
+        template< typename Type_t >
+        struct dependent_false : std::false_type {};
+
+        /** Type of the member referenced by a member pointer
+        */
+        template< typename Member_t >
+        struct member_type;
+
+        template< typename Class_t, typename Field_t >
+        struct member_type< Field_t Class_t::* > { typedef Field_t type; };
+
+        template< typename Members_t >
+        struct wire_size_of;
+
+        template< typename Type_t >
+        constexpr size_t wireSize();
+
+        /** Bytes of a field on the wire in Layout::Packed
+         * @remark Types without a field list are opaque and occupy sizeof(Type_t)
+         */
+        template< typename Type_t >
+        constexpr size_t wireSize()
+        {
+            if constexpr ( std::is_array<Type_t>::value )
+                return std::extent<Type_t>::value * wireSize< typename std::remove_extent<Type_t>::type >();
+            else if constexpr ( hasFields<Type_t> )
+                return wire_size_of< members_t<Type_t> >::value;
+            else
+                return sizeof(Type_t);
+        }
+
+        template< typename... Members_t >
+        struct wire_size_of< std::tuple<Members_t...> >
+        {
+            static constexpr size_t value = ( size_t(0U) + ... + wireSize< typename member_type<Members_t>::type >() );
+        };
+
+        /** Data has no padding so the packed layout equals the in-memory layout
+         * @note Assumes fields are listed in declaration order
+         */
+        template< typename Data >
+        constexpr bool isPacked = (wireSize<Data>() == sizeof(Data));
+
+        constexpr uint16_t byteSwap( const uint16_t value )
+        { return static_cast<uint16_t>( (value << 8U) | (value >> 8U) ); }
+
+        constexpr uint32_t byteSwap( const uint32_t value )
+        {
+            return ((value & 0x000000FFU) << 24U) | ((value & 0x0000FF00U) << 8U)
+                 | ((value & 0x00FF0000U) >> 8U)  | ((value & 0xFF000000U) >> 24U);
+        }
+
+        constexpr uint64_t byteSwap( const uint64_t value )
+        {
+            return (static_cast<uint64_t>( byteSwap( static_cast<uint32_t>(value) ) ) << 32U)
+                 | byteSwap( static_cast<uint32_t>(value >> 32U) );
+        }
+
+        /** Convert a 32-bit value between host and 'cWire' byte order
+        */
+        template< Endian cWire >
+        constexpr uint32_t toWire( const uint32_t value )
+        { return (cWire == Endian::Native) ? value : byteSwap(value); }
+
+        /** Reverse the bytes of a scalar in-place
+         * @remark Loops of this compile to vector byte shuffles where the target supports them
+        */
+        template< typename Type_t >
+        inline void swapScalar( Type_t& value )
+        {
+            if constexpr ( sizeof(Type_t) > 1U )
+            {
+                typedef typename std::conditional< sizeof(Type_t) == 2U, uint16_t
+                      , typename std::conditional< sizeof(Type_t) == 4U, uint32_t, uint64_t >::type >::type Unsigned_t;
+                static_assert( sizeof(Type_t) == sizeof(Unsigned_t), "Sub0Pub - Unsupported scalar size for byte order conversion" );
+
+                Unsigned_t bits;
+                std::memcpy( &bits, &value, sizeof(bits) );
+                bits = byteSwap( bits );
+                std::memcpy( &value, &bits, sizeof(bits) );
+            }
+        }
+
+        template< typename Data >
+        inline void swapFields( Data& data );
+
+        /** Reverse the byte order of each scalar within a field
+        */
+        template< typename Field_t >
+        inline void swapField( Field_t& field )
+        {
+            if constexpr ( isScalar<Field_t> )
+                swapScalar( field );
+            else if constexpr ( std::is_array<Field_t>::value )
+            {
+                for ( auto& element : field )
+                    swapField( element );
+            }
+            else if constexpr ( hasFields<Field_t> )
+                swapFields( field );
+            else
+                static_assert( dependent_false<Field_t>::value, "Sub0Pub - Field type requires a SUB0_FIELDS description" );
+        }
+
+        /** Reverse the byte order of each scalar within the described fields of 'data'
+        */
+        template< typename Data >
+        inline void swapFields( Data& data )
+        {
+            std::apply( [&data]( auto... members ) { ( swapField( data.*members ), ... ); }, Fields<Data>::members() );
+        }
+
+        /** Convert 'data' between host and 'cWire' byte order in-place
+         * @remark No-op when the wire and host byte order match
+        */
+        template< Endian cWire, typename Data >
+        inline void convert( Data& data )
+        {
+            if constexpr ( cWire != Endian::Native )
+            {
+                static_assert( isScalar< typename std::remove_all_extents<Data>::type > || hasFields< typename std::remove_all_extents<Data>::type >
+                             , "Sub0Pub - Data requires a SUB0_FIELDS description for byte order conversion" );
+                swapField( data );
+            }
+        }
+
+        /** Write 'field' to 'out' in Layout::Packed and 'cWire' byte order
+         * @return Byte following the field in 'out'
+        */
+        template< Endian cWire, typename Field_t >
+        inline char* pack( const Field_t& field, char* out )
+        {
+            if constexpr ( isPacked<Field_t> && cWire == Endian::Native )
+            {
+                std::memcpy( out, &field, sizeof(field) ); //< Padding-free fields are copied whole
+                return out + sizeof(field);
+            }
+            else if constexpr ( std::is_array<Field_t>::value )
+            {
+                for ( const auto& element : field )
+                    out = pack<cWire>( element, out );
+                return out;
+            }
+            else if constexpr ( isPacked<Field_t> )
+            {
+                Field_t wire = field;
+                convert<cWire>( wire );
+                std::memcpy( out, &wire, sizeof(wire) );
+                return out + sizeof(field);
+            }
+            else
+            {
+                std::apply( [&field, &out]( auto... members ) { ( (out = pack<cWire>( field.*members, out )), ... ); }, Fields<Field_t>::members() );
+                return out;
+            }
+        }
+
+        /** Read 'field' from 'in' in Layout::Packed and 'cWire' byte order
+         * @return Byte following the field in 'in'
+        */
+        template< Endian cWire, typename Field_t >
+        inline const char* unpack( const char* in, Field_t& field )
+        {
+            if constexpr ( isPacked<Field_t> )
+            {
+                std::memcpy( &field, in, sizeof(field) );
+                convert<cWire>( field );
+                return in + sizeof(field);
+            }
+            else if constexpr ( std::is_array<Field_t>::value )
+            {
+                for ( auto& element : field )
+                    in = unpack<cWire>( in, element );
+                return in;
+            }
+            else
+            {
+                std::apply( [&field, &in]( auto... members ) { ( (in = unpack<cWire>( in, field.*members )), ... ); }, Fields<Field_t>::members() );
+                return in;
+            }
+        }
+    } // END: portable
+
+    /** Writes binary frames with payloads converted to wire byte order and layout
+     * @remark When wire and host byte order match and the layout is native, or Data has no padding, the payload is
+     *  written directly as by BinaryWriter
+     * @see PortableSerialisation
+     */
+    template< typename Prefix_t
+            , typename Header_t
+            , typename Postfix_t
+            , Endian cWire
+            , Layout cLayout = Layout::Native >
+    class PortableWriter : public BinaryWriter<Prefix_t, Header_t, Postfix_t>
+    {
+    public:
+        template<typename Data_t, typename ByteSink>
+        inline bool write(ByteSink& stream, const Data_t& data) const
+        {
+            if constexpr ( cLayout == Layout::Packed && !portable::isPacked<Data_t> )
+            {
+                char wire[portable::wireSize<Data_t>()];
+                portable::pack<cWire>( data, wire );
+                return utility::write<Prefix_t>(stream)
+                    && utility::write(stream, Header_t(data) )
+                    && utility::write(stream, wire, sizeof(wire) )
+                    && utility::write<Postfix_t>(stream);
+            }
+            else if constexpr ( cWire == Endian::Native )
+                return BinaryWriter<Prefix_t, Header_t, Postfix_t>::write(stream, Header_t(data), data);
+            else
+            {
+                Data_t wire = data;
+                portable::convert<cWire>( wire );
+                return BinaryWriter<Prefix_t, Header_t, Postfix_t>::write(stream, Header_t(data), wire);
+            }
+        }
+    };
+
+    /** Buffer register converting payloads written by PortableWriter to host byte order and layout
+     * @remark Payloads in native layout are read into the Data buffer and converted in-place prior to publish. Packed
+     *  payloads of types with padding are read into a staging buffer and scattered into the Data buffer.
+     */
+    template< typename Header_t, Endian cWire, Layout cLayout = Layout::Native, uint_fast16_t cMaxDataBufferCount = 64U >
+    class PortableBufferRegister : public BufferRegister<Header_t, cMaxDataBufferCount>
+    {
+    public:
+        PortableBufferRegister()
+            : BufferRegister<Header_t, cMaxDataBufferCount>()
+            , converters_()
+        {}
+
+        template < typename Data >
+        void set(Data& buffer, IPublish& publisher, const int_least16_t paddingSize = 0U )
+        {
+            if constexpr ( cLayout == Layout::Packed && !portable::isPacked<Data> )
+            {
+                Unpacker<Data>* const unpacker = new Unpacker<Data>( buffer, publisher );
+                converters_.emplace_back( unpacker );
+#if SUB0PUB_TYPEIDNAME
+                const uint32_t typeId = Broker<Data>::typeId();
+#else
+                const uint32_t typeId = 0U;
+#endif
+                BufferRegister<Header_t, cMaxDataBufferCount>::set( Header_t(buffer)
+                    , Buffer{ unpacker, unpacker->staging(), static_cast<uint_least16_t>( portable::wireSize<Data>() ), paddingSize, typeId } );
+            }
+            else if constexpr ( cWire == Endian::Native )
+                BufferRegister<Header_t, cMaxDataBufferCount>::set( buffer, publisher, paddingSize );
+            else
+            {
+                converters_.emplace_back( new Converter<Data>( buffer, publisher ) );
+                BufferRegister<Header_t, cMaxDataBufferCount>::set( buffer, *converters_.back(), paddingSize );
+            }
+        }
+
+    private:
+        /** Owned publisher in place of a registered publisher
+        */
+        class IConverter : public IPublish
+        {
+        public:
+            virtual ~IConverter() = default;
+        };
+
+        /** Converts the Data buffer to host byte order before forwarding publish
+        */
+        template< typename Data >
+        class Converter : public IConverter
+        {
+        public:
+            Converter( Data& buffer, IPublish& publisher )
+                : buffer_(buffer), publisher_(publisher)
+            {}
+
+            void publish() override
+            {
+                portable::convert<cWire>( buffer_ );
+                publisher_.publish();
+            }
+
+            void publish( const MessageInfo& info ) override
+            {
+                portable::convert<cWire>( buffer_ );
+                publisher_.publish( info );
+            }
+
+        private:
+            Data& buffer_;
+            IPublish& publisher_;
+        };
+
+        /** Scatters a packed payload into the Data buffer before forwarding publish
+        */
+        template< typename Data >
+        class Unpacker : public IConverter
+        {
+        public:
+            Unpacker( Data& buffer, IPublish& publisher )
+                : buffer_(buffer), publisher_(publisher), staging_()
+            {}
+
+            char* staging()
+            { return staging_; }
+
+            void publish() override
+            {
+                portable::unpack<cWire>( staging_, buffer_ );
+                publisher_.publish();
+            }
+
+            void publish( const MessageInfo& info ) override
+            {
+                portable::unpack<cWire>( staging_, buffer_ );
+                publisher_.publish( info );
+            }
+
+        private:
+            Data& buffer_;
+            IPublish& publisher_;
+            char staging_[portable::wireSize<Data>()]; ///< Packed payload read from the stream
+        };
+
+        std::vector< std::unique_ptr<IConverter> > converters_;
+    };
+
+    /** Binary protocol with a fixed wire byte order so recordings and links are portable between architectures
+     * @remark Payloads of types not matching the wire byte order are converted field-by-field as described by
+     *  SUB0_FIELDS(Data, ...). When the host matches the wire byte order encoding is a plain memcpy as for
+     *  DefaultSerialisation, and the wire format is identical to DefaultSerialisation on little-endian hosts.
+     * @remark Layout::Packed strips padding bytes of described types, saving bandwidth and never exposing uninitialised
+     *  padding. Types without padding are still copied whole.
+     * @tparam  cWire  Byte order of Prefix, Header and payload on the wire
+     * @tparam  cLayout  Arrangement of payload fields on the wire
+     */
+    template< Endian cWire = Endian::Little, Layout cLayout = Layout::Native >
+    struct PortableSerialisation
+    {
+        struct Prefix
+        {
+            const uint32_t magic = portable::toWire<cWire>( sub0::utility::FourCC<'S', 'U', 'B', '0'>::value ); //< Magic number to identify Sub0 network protocol packets
+
+            bool operator == (const Prefix& rhs) const
+            { return magic == rhs.magic; }
+        };
+
+        /** Header containing signal type information in wire byte order
+        */
+        struct Header : DefaultSerialisation::Header
+        {
+            Header() = default;
+
+            /** header for specified Data type
+            */
+            template<typename Data>
+            Header( const Data& data )
+                : DefaultSerialisation::Header(data)
+            {
+                if constexpr ( cLayout == Layout::Packed )
+                    dataBytes = static_cast<uint32_t>( portable::wireSize<Data>() );
+                typeId = portable::toWire<cWire>( typeId );
+                dataBytes = portable::toWire<cWire>( dataBytes );
+            }
+        };
+
+        typedef DefaultSerialisation::Postfix Postfix;
+
+        using Writer = PortableWriter<Prefix, Header, Postfix, cWire, cLayout>;
+        using Reader = BinaryReader<Prefix, Header, Postfix, PortableBufferRegister<Header, cWire, cLayout> >;
+    };
+
+} // END: sub0
+
+#endif
@@ -0,0 +1,725 @@
+/** Sub0Pub aggregating subscribers reducing numeric topics to running statistics
+ * @remark Opt-in extension of sub0pub.hpp
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#ifndef CROG_SUB0PUB_REDUCE_HPP
+#define CROG_SUB0PUB_REDUCE_HPP
+
+#include "sub0pub/sub0pub.hpp"
+
+#include <algorithm> //< std::fill
+#include <cstring> //< std::memcpy
+#include <limits> //< std::numeric_limits
+#include <type_traits> //< std::is_arithmetic
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h> //< _mm_add_ps
+#define SUB0PUB_REDUCE_SSE2 1
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h> //< _mm256_add_ps
+#endif
+#if defined(__ARM_NEON)
+#include <arm_neon.h> //< vaddq_f32
+#endif
+
+namespace sub0
+{
+    /** Subscribers accumulating statistics of a scalar numeric topic e.g. Subscribe<float>
+     * @remark Samples are buffered and reduced cBatchSize at a time by vector kernels, AVX2, SSE2 or NEON where the
+     *  target enables them, else scalar. Publish<Data>::publish( data, count ) hands a batch to receiveBatch() which
+     *  reduces whole batches in place, without per-sample work. Results include buffered samples.
+     *  e.g.
+     *  sub0::reduce::MeanVariance<float> temperature;
+     *  sub0::reduce::Percentile<float> latency;
+     *  ...
+     *  const double p99 = latency.quantile( 0.99 );
+     * @note Not thread-safe, read results from the publishing thread or between publishes
+     */
+    namespace reduce
+    {
+        namespace detail
+        {
+#if SUB0PUB_REDUCE_SSE2
+            inline float horizontalSum( __m128 values )
+            {
+                values = _mm_add_ps( values, _mm_movehl_ps( values, values ) );
+                values = _mm_add_ss( values, _mm_shuffle_ps( values, values, 0x55 ) );
+                return _mm_cvtss_f32( values );
+            }
+#endif
+#if defined(__AVX2__)
+            inline float horizontalSum( const __m256 values )
+            { return horizontalSum( _mm_add_ps( _mm256_castps256_ps128( values ), _mm256_extractf128_ps( values, 1 ) ) ); }
+#endif
+#if defined(__ARM_NEON)
+            inline float horizontalSum( const float32x4_t values )
+            {
+                const float32x2_t pairs = vadd_f32( vget_low_f32( values ), vget_high_f32( values ) );
+                return vget_lane_f32( vpadd_f32( pairs, pairs ), 0 );
+            }
+#endif
+
+            /** @return Sum of 'values'
+            */
+            inline float sum( const float* const values, const size_t count )
+            {
+                size_t position = 0U;
+                float total = 0.0f;
+#if defined(__AVX2__)
+                __m256 total0 = _mm256_setzero_ps();
+                __m256 total1 = _mm256_setzero_ps(); //< Second chain hides the add latency
+                for ( ; position < (count & ~size_t(15)); position += 16U )
+                {
+                    total0 = _mm256_add_ps( total0, _mm256_loadu_ps( values + position ) );
+                    total1 = _mm256_add_ps( total1, _mm256_loadu_ps( values + position + 8U ) );
+                }
+                total += horizontalSum( _mm256_add_ps( total0, total1 ) );
+#endif
+#if SUB0PUB_REDUCE_SSE2
+                __m128 total4 = _mm_setzero_ps();
+                for ( ; position < (count & ~size_t(3)); position += 4U )
+                    total4 = _mm_add_ps( total4, _mm_loadu_ps( values + position ) );
+                total += horizontalSum( total4 );
+#elif defined(__ARM_NEON)
+                float32x4_t total4 = vdupq_n_f32( 0.0f );
+                for ( ; position < (count & ~size_t(3)); position += 4U )
+                    total4 = vaddq_f32( total4, vld1q_f32( values + position ) );
+                total += horizontalSum( total4 );
+#endif
+                for ( ; position < count; ++position )
+                    total += values[position];
+                return total;
+            }
+
+            /** @return Sum of squared differences of 'values' from 'mean'
+            */
+            inline float squaredDeviation( const float* const values, const size_t count, const float mean )
+            {
+                size_t position = 0U;
+                float total = 0.0f;
+#if defined(__AVX2__)
+                const __m256 mean8 = _mm256_set1_ps( mean );
+                __m256 total8 = _mm256_setzero_ps();
+                for ( ; position < (count & ~size_t(7)); position += 8U )
+                {
+                    const __m256 deviation = _mm256_sub_ps( _mm256_loadu_ps( values + position ), mean8 );
+                    total8 = _mm256_add_ps( total8, _mm256_mul_ps( deviation, deviation ) );
+                }
+                total += horizontalSum( total8 );
+#endif
+#if SUB0PUB_REDUCE_SSE2
+                const __m128 mean4 = _mm_set1_ps( mean );
+                __m128 total4 = _mm_setzero_ps();
+                for ( ; position < (count & ~size_t(3)); position += 4U )
+                {
+                    const __m128 deviation = _mm_sub_ps( _mm_loadu_ps( values + position ), mean4 );
+                    total4 = _mm_add_ps( total4, _mm_mul_ps( deviation, deviation ) );
+                }
+                total += horizontalSum( total4 );
+#elif defined(__ARM_NEON)
+                const float32x4_t mean4 = vdupq_n_f32( mean );
+                float32x4_t total4 = vdupq_n_f32( 0.0f );
+                for ( ; position < (count & ~size_t(3)); position += 4U )
+                {
+                    const float32x4_t deviation = vsubq_f32( vld1q_f32( values + position ), mean4 );
+                    total4 = vmlaq_f32( total4, deviation, deviation );
+                }
+                total += horizontalSum( total4 );
+#endif
+                for ( ; position < count; ++position )
+                {
+                    const float deviation = values[position] - mean;
+                    total += deviation * deviation;
+                }
+                return total;
+            }
+
+            /** Widen [min, max] to include 'values', NaN is ignored
+            */
+            inline void minMax( const float* const values, const size_t count, float& min, float& max )
+            {
+                size_t position = 0U;
+#if defined(__AVX2__)
+                __m256 min8 = _mm256_set1_ps( min );
+                __m256 max8 = _mm256_set1_ps( max );
+                for ( ; position < (count & ~size_t(7)); position += 8U )
+                {
+                    const __m256 value = _mm256_loadu_ps( values + position );
+                    min8 = _mm256_min_ps( value, min8 ); //< Second operand is returned for NaN
+                    max8 = _mm256_max_ps( value, max8 );
+                }
+                float mins8[8];
+                float maxs8[8];
+                _mm256_storeu_ps( mins8, min8 );
+                _mm256_storeu_ps( maxs8, max8 );
+                for ( size_t iLane = 0U; iLane < 8U; ++iLane )
+                {
+                    min = (mins8[iLane] < min) ? mins8[iLane] : min;
+                    max = (maxs8[iLane] > max) ? maxs8[iLane] : max;
+                }
+#endif
+#if SUB0PUB_REDUCE_SSE2
+                __m128 min4 = _mm_set1_ps( min );
+                __m128 max4 = _mm_set1_ps( max );
+                for ( ; position < (count & ~size_t(3)); position += 4U )
+                {
+                    const __m128 value = _mm_loadu_ps( values + position );
+                    min4 = _mm_min_ps( value, min4 );
+                    max4 = _mm_max_ps( value, max4 );
+                }
+                float mins[4];
+                float maxs[4];
+                _mm_storeu_ps( mins, min4 );
+                _mm_storeu_ps( maxs, max4 );
+#elif defined(__ARM_NEON)
+                float32x4_t min4 = vdupq_n_f32( min );
+                float32x4_t max4 = vdupq_n_f32( max );
+                for ( ; position < (count & ~size_t(3)); position += 4U )
+                {
+                    const float32x4_t value = vld1q_f32( values + position );
+                    min4 = vbslq_f32( vcltq_f32( value, min4 ), value, min4 ); //< Compare is false for NaN
+                    max4 = vbslq_f32( vcgtq_f32( value, max4 ), value, max4 );
+                }
+                float mins[4];
+                float maxs[4];
+                vst1q_f32( mins, min4 );
+                vst1q_f32( maxs, max4 );
+#endif
+#if SUB0PUB_REDUCE_SSE2 || defined(__ARM_NEON)
+                for ( size_t iLane = 0U; iLane < 4U; ++iLane )
+                {
+                    min = (mins[iLane] < min) ? mins[iLane] : min;
+                    max = (maxs[iLane] > max) ? maxs[iLane] : max;
+                }
+#endif
+                for ( ; position < count; ++position )
+                {
+                    min = (values[position] < min) ? values[position] : min;
+                    max = (values[position] > max) ? values[position] : max;
+                }
+            }
+
+            /** Index each value into 'last' + 1 slots: (value - origin) * scale + 1 truncated and clamped to [0, last]
+             * @remark Slot 0 collects values below origin and NaN, 'last' values at or above the end of the range
+             */
+            inline void binIndex( const float* const values, const size_t count, const float origin, const float scale, const uint32_t last, uint32_t* const indices )
+            {
+                size_t position = 0U;
+                const float upper = static_cast<float>( last );
+#if defined(__AVX2__)
+                const __m256 origin8 = _mm256_set1_ps( origin );
+                const __m256 scale8 = _mm256_set1_ps( scale );
+                const __m256 one8 = _mm256_set1_ps( 1.0f );
+                const __m256 zero8 = _mm256_setzero_ps();
+                const __m256 upper8 = _mm256_set1_ps( upper );
+                for ( ; position < (count & ~size_t(7)); position += 8U )
+                {
+                    __m256 slot = _mm256_add_ps( _mm256_mul_ps( _mm256_sub_ps( _mm256_loadu_ps( values + position ), origin8 ), scale8 ), one8 );
+                    slot = _mm256_min_ps( _mm256_max_ps( slot, zero8 ), upper8 ); //< max returns zero for NaN
+                    _mm256_storeu_si256( reinterpret_cast<__m256i*>( indices + position ), _mm256_cvttps_epi32( slot ) );
+                }
+#endif
+#if SUB0PUB_REDUCE_SSE2
+                const __m128 origin4 = _mm_set1_ps( origin );
+                const __m128 scale4 = _mm_set1_ps( scale );
+                const __m128 one4 = _mm_set1_ps( 1.0f );
+                const __m128 zero4 = _mm_setzero_ps();
+                const __m128 upper4 = _mm_set1_ps( upper );
+                for ( ; position < (count & ~size_t(3)); position += 4U )
+                {
+                    __m128 slot = _mm_add_ps( _mm_mul_ps( _mm_sub_ps( _mm_loadu_ps( values + position ), origin4 ), scale4 ), one4 );
+                    slot = _mm_min_ps( _mm_max_ps( slot, zero4 ), upper4 );
+                    _mm_storeu_si128( reinterpret_cast<__m128i*>( indices + position ), _mm_cvttps_epi32( slot ) );
+                }
+#elif defined(__ARM_NEON)
+                const float32x4_t origin4 = vdupq_n_f32( origin );
+                const float32x4_t scale4 = vdupq_n_f32( scale );
+                const float32x4_t one4 = vdupq_n_f32( 1.0f );
+                const float32x4_t zero4 = vdupq_n_f32( 0.0f );
+                const float32x4_t upper4 = vdupq_n_f32( upper );
+                for ( ; position < (count & ~size_t(3)); position += 4U )
+                {
+                    float32x4_t slot = vmlaq_f32( one4, vsubq_f32( vld1q_f32( values + position ), origin4 ), scale4 );
+                    slot = vbslq_f32( vcgtq_f32( slot, zero4 ), slot, zero4 ); //< Compare is false for NaN
+                    slot = vbslq_f32( vcltq_f32( slot, upper4 ), slot, upper4 );
+                    vst1q_u32( indices + position, vcvtq_u32_f32( slot ) );
+                }
+#endif
+                for ( ; position < count; ++position )
+                {
+                    float slot = (values[position] - origin) * scale + 1.0f;
+                    slot = (slot > 0.0f) ? slot : 0.0f;
+                    slot = (slot < upper) ? slot : upper;
+                    indices[position] = static_cast<uint32_t>( slot );
+                }
+            }
+
+            /** Index each value by its float exponent and leading 'cMantissaBits' mantissa bits
+             * @remark Buckets are monotonic in value and span a relative width of 2^-cMantissaBits. Negative values
+             *  and NaN are indexed as zero.
+             */
+            template< uint32_t cMantissaBits >
+            inline void bucketIndex( const float* const values, const size_t count, uint32_t* const indices )
+            {
+                const int cShift = 23 - static_cast<int>( cMantissaBits );
+                size_t position = 0U;
+#if defined(__AVX2__)
+                const __m256 zero8 = _mm256_setzero_ps();
+                for ( ; position < (count & ~size_t(7)); position += 8U )
+                {
+                    const __m256 value = _mm256_max_ps( _mm256_loadu_ps( values + position ), zero8 );
+                    _mm256_storeu_si256( reinterpret_cast<__m256i*>( indices + position ), _mm256_srli_epi32( _mm256_castps_si256( value ), cShift ) );
+                }
+#endif
+#if SUB0PUB_REDUCE_SSE2
+                const __m128 zero4 = _mm_setzero_ps();
+                for ( ; position < (count & ~size_t(3)); position += 4U )
+                {
+                    const __m128 value = _mm_max_ps( _mm_loadu_ps( values + position ), zero4 );
+                    _mm_storeu_si128( reinterpret_cast<__m128i*>( indices + position ), _mm_srli_epi32( _mm_castps_si128( value ), cShift ) );
+                }
+#elif defined(__ARM_NEON)
+                const float32x4_t zero4 = vdupq_n_f32( 0.0f );
+                for ( ; position < (count & ~size_t(3)); position += 4U )
+                {
+                    float32x4_t value = vld1q_f32( values + position );
+                    value = vbslq_f32( vcgtq_f32( value, zero4 ), value, zero4 );
+                    vst1q_u32( indices + position, vshrq_n_u32( vreinterpretq_u32_f32( value ), 23 - cMantissaBits ) );
+                }
+#endif
+                for ( ; position < count; ++position )
+                {
+                    const float value = (values[position] > 0.0f) ? values[position] : 0.0f;
+                    uint32_t bits;
+                    std::memcpy( &bits, &value, sizeof(bits) );
+                    indices[position] = bits >> cShift;
+                }
+            }
+
+            /** Subscription buffering samples of Data for Derived::accumulate( values, count )
+             * @tparam Derived  Reduction implementing accumulate() and clear()
+             */
+            template< typename Data, typename Derived >
+            class Reduction : public Subscribe<Data>
+            {
+                static_assert( std::is_arithmetic<Data>::value, "Reductions require a scalar numeric Data type" );
+
+            public:
+                static const size_t cBatchSize = 256U; ///< Samples reduced per kernel call
+
+            public:
+                Reduction()
+                    : pendingCount_( 0U )
+                    , count_( 0U )
+                {}
+
+                /** Buffer a sample, reducing the buffer once full
+                 */
+                void receive( const Data& data ) override
+                {
+                    buffer_[pendingCount_] = data;
+                    if ( ++pendingCount_ == cBatchSize )
+                        flush();
+                }
+
+                /** Reduce whole batches in place and buffer the remainder
+                 * @remark Subscribe<Data>::filter() is not applied
+                 */
+                void receiveBatch( const Data* data, size_t count ) override
+                {
+                    if ( pendingCount_ != 0U )
+                    {
+                        const size_t free = cBatchSize - pendingCount_;
+                        const size_t copied = (count < free) ? count : free;
+                        std::memcpy( buffer_ + pendingCount_, data, copied * sizeof(Data) );
+                        pendingCount_ += copied;
+                        data += copied;
+                        count -= copied;
+                        if ( pendingCount_ != cBatchSize )
+                            return;
+                        flush();
+                    }
+
+                    for ( ; count >= cBatchSize; data += cBatchSize, count -= cBatchSize )
+                        reduce( data, cBatchSize );
+                    std::memcpy( buffer_, data, count * sizeof(Data) );
+                    pendingCount_ = count;
+                }
+
+                /** Reduce buffered samples so results are current
+                 */
+                void flush()
+                {
+                    const size_t pendingCount = pendingCount_;
+                    if ( pendingCount == 0U )
+                        return;
+                    pendingCount_ = 0U; //< count() excludes the samples until reduced
+                    reduce( buffer_, pendingCount );
+                }
+
+                /** @return Count of samples received
+                 */
+                uint64_t count() const
+                { return count_ + pendingCount_; }
+
+                /** Discard all samples
+                 */
+                void reset()
+                {
+                    pendingCount_ = 0U;
+                    count_ = 0U;
+                    static_cast<Derived*>( this )->clear();
+                }
+
+            protected:
+                /** @return 'values' as float, converted into 'scratch' unless Data is float
+                 */
+                static const float* asFloat( const Data* const values, const size_t count, float* const scratch )
+                {
+                    if constexpr ( std::is_same<Data, float>::value )
+                        return values;
+                    else
+                    {
+                        for ( size_t iValue = 0U; iValue < count; ++iValue )
+                            scratch[iValue] = static_cast<float>( values[iValue] );
+                        return scratch;
+                    }
+                }
+
+            private:
+                void reduce( const Data* const values, const size_t count )
+                {
+                    static_cast<Derived*>( this )->accumulate( values, count );
+                    count_ += count;
+                }
+
+            private:
+                alignas(32) Data buffer_[cBatchSize]; ///< Samples not yet reduced
+                size_t pendingCount_;
+                uint64_t count_; ///< Samples reduced
+            };
+
+        } // END: detail
+
+        /** Running sum of Data
+         * @remark Floating-point samples are summed per batch in float and totalled in double
+         */
+        template< typename Data >
+        class Sum : public detail::Reduction< Data, Sum<Data> >
+        {
+            friend class detail::Reduction< Data, Sum<Data> >;
+
+        public:
+            typedef std::conditional_t< std::is_floating_point<Data>::value, double
+                  , std::conditional_t< std::is_signed<Data>::value, int64_t, uint64_t > > Total;
+
+            Sum()
+                : total_( 0 )
+            {}
+
+            /** @return Sum of samples received
+             */
+            Total sum()
+            {
+                this->flush();
+                return total_;
+            }
+
+        private:
+            void accumulate( const Data* const values, const size_t count )
+            {
+                if constexpr ( std::is_same<Data, float>::value )
+                    total_ += detail::sum( values, count );
+                else
+                {
+                    Total total = 0;
+                    for ( size_t iValue = 0U; iValue < count; ++iValue )
+                        total += static_cast<Total>( values[iValue] );
+                    total_ += total;
+                }
+            }
+
+            void clear()
+            { total_ = 0; }
+
+        private:
+            Total total_;
+        };
+
+        /** Running minimum and maximum of Data
+         * @remark NaN samples are ignored
+         */
+        template< typename Data >
+        class MinMax : public detail::Reduction< Data, MinMax<Data> >
+        {
+            friend class detail::Reduction< Data, MinMax<Data> >;
+
+        public:
+            MinMax()
+            { clear(); }
+
+            /** @return Smallest sample received, numeric_limits<Data>::max() or infinity if none
+             */
+            Data min()
+            {
+                this->flush();
+                return min_;
+            }
+
+            /** @return Largest sample received, numeric_limits<Data>::lowest() or -infinity if none
+             */
+            Data max()
+            {
+                this->flush();
+                return max_;
+            }
+
+        private:
+            void accumulate( const Data* const values, const size_t count )
+            {
+                if constexpr ( std::is_same<Data, float>::value )
+                    detail::minMax( values, count, min_, max_ );
+                else
+                {
+                    for ( size_t iValue = 0U; iValue < count; ++iValue )
+                    {
+                        min_ = (values[iValue] < min_) ? values[iValue] : min_;
+                        max_ = (values[iValue] > max_) ? values[iValue] : max_;
+                    }
+                }
+            }
+
+            void clear()
+            {
+                min_ = std::numeric_limits<Data>::has_infinity ? std::numeric_limits<Data>::infinity() : std::numeric_limits<Data>::max();
+                max_ = std::numeric_limits<Data>::has_infinity ? -std::numeric_limits<Data>::infinity() : std::numeric_limits<Data>::lowest();
+            }
+
+        private:
+            Data min_;
+            Data max_;
+        };
+
+        /** Running mean and variance of Data
+         * @remark Each batch is reduced to its own mean and squared deviation in two passes then merged with the
+         *  running totals in double (Chan et al.), avoiding the cancellation of a sum of squares
+         */
+        template< typename Data >
+        class MeanVariance : public detail::Reduction< Data, MeanVariance<Data> >
+        {
+            friend class detail::Reduction< Data, MeanVariance<Data> >;
+
+        public:
+            MeanVariance()
+                : mean_( 0.0 )
+                , squaredDeviation_( 0.0 )
+            {}
+
+            /** @return Mean of samples received, zero if none
+             */
+            double mean()
+            {
+                this->flush();
+                return mean_;
+            }
+
+            /** @return Population variance of samples received, zero if none
+             */
+            double variance()
+            {
+                this->flush();
+                return (this->count() != 0U) ? squaredDeviation_ / static_cast<double>( this->count() ) : 0.0;
+            }
+
+            /** @return Unbiased sample variance of samples received, zero if fewer than two
+             */
+            double sampleVariance()
+            {
+                this->flush();
+                return (this->count() > 1U) ? squaredDeviation_ / static_cast<double>( this->count() - 1U ) : 0.0;
+            }
+
+        private:
+            void accumulate( const Data* const values, const size_t count )
+            {
+                double batchMean;
+                double batchDeviation;
+                if constexpr ( std::is_same<Data, float>::value )
+                {
+                    const float mean = detail::sum( values, count ) / static_cast<float>( count );
+                    batchMean = mean;
+                    batchDeviation = detail::squaredDeviation( values, count, mean );
+                }
+                else
+                {
+                    double total = 0.0;
+                    for ( size_t iValue = 0U; iValue < count; ++iValue )
+                        total += static_cast<double>( values[iValue] );
+                    batchMean = total / static_cast<double>( count );
+                    batchDeviation = 0.0;
+                    for ( size_t iValue = 0U; iValue < count; ++iValue )
+                    {
+                        const double deviation = static_cast<double>( values[iValue] ) - batchMean;
+                        batchDeviation += deviation * deviation;
+                    }
+                }
+
+                const double previousCount = static_cast<double>( this->count() ); //< Excludes this batch until accumulated
+                const double batchCount = static_cast<double>( count );
+                const double totalCount = previousCount + batchCount;
+                const double delta = batchMean - mean_;
+                mean_ += delta * (batchCount / totalCount);
+                squaredDeviation_ += batchDeviation + delta * delta * (previousCount * batchCount / totalCount);
+            }
+
+            void clear()
+            {
+                mean_ = 0.0;
+                squaredDeviation_ = 0.0;
+            }
+
+        private:
+            double mean_;
+            double squaredDeviation_; ///< Sum of squared differences from mean_
+        };
+
+        /** Count of Data in cBinCount equal bins over [lower, upper)
+         * @remark Samples outside the range are counted by underflow() and overflow(), NaN as underflow
+         * @tparam cBinCount  Count of bins within the range
+         */
+        template< typename Data, uint32_t cBinCount >
+        class Histogram : public detail::Reduction< Data, Histogram<Data, cBinCount> >
+        {
+            friend class detail::Reduction< Data, Histogram<Data, cBinCount> >;
+            static_assert( cBinCount != 0U, "Histogram requires at least one bin" );
+
+        public:
+            Histogram( const float lower, const float upper )
+                : lower_( lower )
+                , scale_( static_cast<float>( cBinCount ) / (upper - lower) )
+                , counts_()
+            {}
+
+            /** @return Count of samples in bin 'index' of [lower + index * width, lower + (index + 1) * width)
+             */
+            uint64_t bin( const uint32_t index )
+            {
+                this->flush();
+                return counts_[1U + index];
+            }
+
+            /** @return Count of samples below lower
+             */
+            uint64_t underflow()
+            {
+                this->flush();
+                return counts_[0U];
+            }
+
+            /** @return Count of samples at or above upper
+             */
+            uint64_t overflow()
+            {
+                this->flush();
+                return counts_[cBinCount + 1U];
+            }
+
+            /** @return Lower bound of bin 'index'
+             */
+            float binLower( const uint32_t index ) const
+            { return lower_ + static_cast<float>( index ) / scale_; }
+
+        private:
+            void accumulate( const Data* const values, const size_t count )
+            {
+                float scratch[detail::Reduction< Data, Histogram >::cBatchSize];
+                uint32_t indices[detail::Reduction< Data, Histogram >::cBatchSize];
+                detail::binIndex( this->asFloat( values, count, scratch ), count, lower_, scale_, cBinCount + 1U, indices );
+                for ( size_t iValue = 0U; iValue < count; ++iValue )
+                    ++counts_[indices[iValue]];
+            }
+
+            void clear()
+            { std::fill( counts_, counts_ + cBinCount + 2U, 0U ); }
+
+        private:
+            float lower_;
+            float scale_; ///< Bins per unit of Data
+            uint64_t counts_[cBinCount + 2U]; ///< Underflow, bins, overflow
+        };
+
+        /** Quantiles of non-negative Data within a relative error, e.g. latency percentiles
+         * @remark Buckets span a relative width of 2^-cPrecisionBits indexed directly from the float bits, so memory
+         *  is fixed for any range and the reported quantile is within half a bucket, 3.1% at the default precision.
+         *  Negative samples are counted as zero.
+         * @tparam cPrecisionBits  Mantissa bits indexed, each doubles the 256 << cPrecisionBits counts
+         */
+        template< typename Data, uint32_t cPrecisionBits = 4U >
+        class Percentile : public detail::Reduction< Data, Percentile<Data, cPrecisionBits> >
+        {
+            friend class detail::Reduction< Data, Percentile<Data, cPrecisionBits> >;
+            static_assert( cPrecisionBits >= 1U && cPrecisionBits <= 10U, "Percentile precision of 1 to 10 bits" );
+
+        public:
+            static const uint32_t cBucketCount = 256U << cPrecisionBits; ///< Sign-less exponent and mantissa bits
+
+            Percentile()
+                : counts_()
+            {}
+
+            /** Estimate the value below which 'fraction' of samples fall
+             * @param fraction  Quantile in [0, 1] e.g. 0.99 for the 99th percentile
+             * @return Centre of the bucket holding the quantile, zero if no samples
+             */
+            double quantile( const double fraction )
+            {
+                this->flush();
+                const uint64_t count = this->count();
+                if ( count == 0U )
+                    return 0.0;
+
+                const double clamped = (fraction < 0.0) ? 0.0 : ((fraction > 1.0) ? 1.0 : fraction);
+                const uint64_t rank = static_cast<uint64_t>( clamped * static_cast<double>( count - 1U ) );
+                uint64_t below = 0U;
+                uint32_t iBucket = 0U;
+                for ( ; iBucket + 1U < cBucketCount; ++iBucket )
+                {
+                    below += counts_[iBucket];
+                    if ( below > rank )
+                        break;
+                }
+                return 0.5 * (bucketLower( iBucket ) + bucketLower( iBucket + 1U ));
+            }
+
+        private:
+            static double bucketLower( const uint32_t index )
+            {
+                const uint32_t bits = index << (23U - cPrecisionBits);
+                float value;
+                std::memcpy( &value, &bits, sizeof(value) );
+                return value;
+            }
+
+            void accumulate( const Data* const values, const size_t count )
+            {
+                float scratch[detail::Reduction< Data, Percentile >::cBatchSize];
+                uint32_t indices[detail::Reduction< Data, Percentile >::cBatchSize];
+                detail::bucketIndex<cPrecisionBits>( this->asFloat( values, count, scratch ), count, indices );
+                for ( size_t iValue = 0U; iValue < count; ++iValue )
+                    ++counts_[indices[iValue]];
+            }
+
+            void clear()
+            { std::fill( counts_, counts_ + cBucketCount, 0U ); }
+
+        private:
+            uint64_t counts_[cBucketCount];
+        };
+
+    } // END: reduce
+
+} // END: sub0
+
+#endif // CROG_SUB0PUB_REDUCE_HPP
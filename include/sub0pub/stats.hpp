@@ -0,0 +1,165 @@
+/** Sub0Pub shared-memory page of topic counters for monitoring by another process e.g. sub0top
+ * @remark Opt-in extension of sub0pub.hpp, requires SUB0PUB_STATS and POSIX shared memory
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#ifndef CROG_SUB0PUB_STATS_HPP
+#define CROG_SUB0PUB_STATS_HPP
+
+#include "sub0pub/sub0pub.hpp"
+
+#include <cstdio> //< std::snprintf
+#include <new> //< placement new
+
+#include <fcntl.h> //< O_CREAT
+#include <sys/mman.h> //< shm_open, mmap
+#include <sys/stat.h> //< fstat
+#include <unistd.h> //< ftruncate, getpid
+
+#if !SUB0PUB_STATS
+#error "sub0pub/stats.hpp requires SUB0PUB_STATS=true"
+#endif
+
+namespace sub0
+{
+    /** Shared-memory page mirroring Stats of this process
+     * @remark The page is created and mapped once by open(), after which counters are updated in place with no lock
+     *  or system call. Other processes map it read-only with StatsReader.
+     */
+    class StatsPage
+    {
+    public:
+        StatsPage()
+            : layout_( nullptr )
+            , name_()
+        {}
+
+        ~StatsPage()
+        { close(); }
+
+        StatsPage( const StatsPage& ) = delete;
+        StatsPage& operator=( const StatsPage& ) = delete;
+
+        /** Create the page and attach Stats to it
+         * @param name  Shared-memory object name, nullptr for defaultName() of this process
+         * @return False if the page could not be created, Stats remain in process memory
+         */
+        bool open( const char* const name = nullptr )
+        {
+            close();
+            const uint32_t processId = static_cast<uint32_t>( getpid() );
+            if ( name != nullptr )
+                std::snprintf( name_, sizeof(name_), "%s", name );
+            else
+                defaultName( processId, name_, sizeof(name_) );
+
+            const int fd = shm_open( name_, O_CREAT | O_RDWR | O_TRUNC, 0644 );
+            if ( fd < 0 )
+                return false;
+            void* const memory = (ftruncate( fd, sizeof(StatsLayout) ) == 0)
+                ? mmap( nullptr, sizeof(StatsLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 ) : MAP_FAILED;
+            ::close( fd );
+            if ( memory == MAP_FAILED )
+            {
+                shm_unlink( name_ );
+                return false;
+            }
+
+            layout_ = new (memory) StatsLayout; //< Zeroed by ftruncate
+            Stats::attach( *layout_, processId );
+            return true;
+        }
+
+        /** Detach Stats back to process memory and remove the page
+         */
+        void close()
+        {
+            if ( layout_ == nullptr )
+                return;
+            Stats::detach();
+            munmap( layout_, sizeof(StatsLayout) );
+            shm_unlink( name_ );
+            layout_ = nullptr;
+        }
+
+        bool isOpen() const
+        { return layout_ != nullptr; }
+
+        /** @return Shared-memory object name of the open page
+         */
+        const char* name() const
+        { return name_; }
+
+        /** Name of the page of a process opened with the default name e.g. "/sub0pub.1234"
+         */
+        static void defaultName( const uint32_t processId, char* const name, const size_t size )
+        { std::snprintf( name, size, "/sub0pub.%u", static_cast<unsigned>( processId ) ); }
+
+    private:
+        StatsLayout* layout_; ///< Mapped page, nullptr when closed
+        char name_[64];
+    };
+
+    /** Read-only mapping of the StatsPage of another process
+     */
+    class StatsReader
+    {
+    public:
+        StatsReader()
+            : layout_( nullptr )
+        {}
+
+        ~StatsReader()
+        { close(); }
+
+        StatsReader( const StatsReader& ) = delete;
+        StatsReader& operator=( const StatsReader& ) = delete;
+
+        /** Map a page created by StatsPage::open
+         * @return False if the page does not exist or is not a compatible StatsLayout
+         */
+        bool open( const char* const name )
+        {
+            close();
+            const int fd = shm_open( name, O_RDONLY, 0 );
+            if ( fd < 0 )
+                return false;
+            struct stat status;
+            if ( fstat( fd, &status ) != 0 || status.st_size < static_cast<off_t>( sizeof(StatsLayout) ) )
+            {
+                ::close( fd ); //< Not yet sized by StatsPage::open, reading the mapping would fault
+                return false;
+            }
+            void* const memory = mmap( nullptr, sizeof(StatsLayout), PROT_READ, MAP_SHARED, fd, 0 );
+            ::close( fd );
+            if ( memory == MAP_FAILED )
+                return false;
+
+            layout_ = static_cast<const StatsLayout*>( memory );
+            if ( layout_->magic != StatsLayout::cMagic || layout_->version != StatsLayout::cVersion )
+            {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        void close()
+        {
+            if ( layout_ != nullptr )
+                munmap( const_cast<StatsLayout*>( layout_ ), sizeof(StatsLayout) );
+            layout_ = nullptr;
+        }
+
+        /** @return Mapped layout, nullptr when closed
+         */
+        const StatsLayout* layout() const
+        { return layout_; }
+
+    private:
+        const StatsLayout* layout_;
+    };
+
+} // END: sub0
+
+#endif // CROG_SUB0PUB_STATS_HPP
@@ -25,7 +25,9 @@
 #include <algorithm>
 #include <cassert> //< assert
 #include <cstring> //< std::strcmp
+#include <stdexcept> //< std::runtime_error
 #include <array> //< std::array @todo Should we not use this one occurrence for C++98 compatibility?
+#include <atomic> //< std::atomic
 #include <iosfwd> //< std::istream, std::ostream
 #include <tuple> //< std::tuple
 #include <type_traits> //< std::is_same
@@ -64,6 +66,53 @@
 #define SUB0_EXPERIMENTAL false ///< Experimental functionality that may be later removed/dropped
 #endif
 
+/** Time-stamp counter source for MessageInfo timestamps
+ * Define SUB0PUB_TSC=true to read the CPU time-stamp counter where available, SUB0PUB_TSC=false to use std::chrono::steady_clock
+ */
+#ifndef SUB0PUB_TSC
+#define SUB0PUB_TSC true ///< Use time-stamp counter by default
+#endif
+
+/** Per-subscriber receive() profiling
+ * Define SUB0PUB_PROFILE=true to time each Subscribe<Data>::receive() into a ReceiveProfile, SUB0PUB_PROFILE=false
+ *  compiles the timing out of Broker<Data>::publish
+ */
+#ifndef SUB0PUB_PROFILE
+#define SUB0PUB_PROFILE false ///< Disable receive profiling by default
+#endif
+
+/** Publish and receive span recording
+ * Define SUB0PUB_TRACE_EVENTS=true to record publish and receive spans into per-thread TraceBuffer for export
+ *  e.g. As Chrome trace-event JSON @see trace.hpp, SUB0PUB_TRACE_EVENTS=false compiles the recording out
+ */
+#ifndef SUB0PUB_TRACE_EVENTS
+#define SUB0PUB_TRACE_EVENTS false ///< Disable span recording by default
+#endif
+
+/** USDT static tracepoints for perf, bpftrace and SystemTap
+ * Define SUB0PUB_USDT=true to emit `sys/sdt.h` compatible probes where supported, SUB0PUB_USDT=false to compile them out
+ * @remark Each probe is a single nop until a tracer attaches e.g. `bpftrace -e 'usdt:./app:sub0pub:receive_begin { ... }'`
+ */
+#ifndef SUB0PUB_USDT
+#define SUB0PUB_USDT true ///< Enable probes by default
+#endif
+
+/** Causality tracking of publishes made from within receive()
+ * Define SUB0PUB_CAUSALITY=true to give each publish a SpanContext inherited by publishes made during its delivery,
+ *  SUB0PUB_CAUSALITY=false compiles the tracking out of Broker<Data>::publish
+ */
+#ifndef SUB0PUB_CAUSALITY
+#define SUB0PUB_CAUSALITY false ///< Disable causality tracking by default
+#endif
+
+/** Per-topic counters for live monitoring
+ * Define SUB0PUB_STATS=true to count publishes, deliveries and publish durations of each topic into a StatsLayout that
+ *  may be mirrored to shared memory @see stats.hpp, SUB0PUB_STATS=false compiles the counting out
+ */
+#ifndef SUB0PUB_STATS
+#define SUB0PUB_STATS false ///< Disable topic counters by default
+#endif
+
 /** Helper macro for stringifying value using compiler preprocessor
  * e.g. SUB0_STRINGIFY_HELPER(123) == "123", SUB0_STRINGIFY_HELPER(FooBar) == "FooBar"
  * @param  x  A value whos value will be converted to string e.g. FooBar == "FooBar", 123 = "123"
@@ -81,11 +130,90 @@
 #include <istream> //< std::istream
 #endif
 
+#include <chrono> //< std::chrono::steady_clock
+
+#if SUB0PUB_TSC && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h> //< __rdtsc
+#define SUB0PUB_HAS_TSC true
+#elif SUB0PUB_TSC && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h> //< __rdtsc
+#define SUB0PUB_HAS_TSC true
+#else
+#define SUB0PUB_HAS_TSC false
+#endif
+
+#if SUB0PUB_USDT && defined(__ELF__) && (defined(__x86_64__) || defined(__aarch64__)) && (defined(__GNUC__) || defined(__clang__))
+#define SUB0PUB_HAS_USDT true
+#else
+#define SUB0PUB_HAS_USDT false
+#endif
+
+/** Static tracepoint of provider 'sub0pub' @see SUB0PUB_USDT
+ * @remark Emits a nop and a `.note.stapsdt` entry describing the argument locations, as `STAP_PROBE3` of `sys/sdt.h`
+ *  without the dependency. Arguments are kept in registers or memory and only read by an attached tracer.
+ * @param name  Probe name e.g. publish_begin
+ * @param typeId  arg0 Broker<Data>::typeId() or Buffer::typeId of the frame, 0 unless SUB0PUB_TYPEIDNAME
+ * @param data  arg1 Pointer to the message or frame payload
+ * @param size  arg2 Size of the message or frame payload in bytes
+ */
+#if SUB0PUB_HAS_USDT
+#define SUB0_PROBE(name, typeId, data, size) \
+    __asm__ __volatile__ ( \
+        "990: nop\n" \
+        ".pushsection .note.stapsdt,\"?\",\"note\"\n" \
+        ".balign 4\n" \
+        ".4byte 992f-991f, 994f-993f, 3\n" \
+        "991: .asciz \"stapsdt\"\n" \
+        "992: .balign 4\n" \
+        "993: .8byte 990b\n" \
+        ".8byte _.stapsdt.base\n" \
+        ".8byte 0\n" /*< No semaphore, arguments are never computed for the probe */ \
+        ".asciz \"sub0pub\"\n" \
+        ".asciz \"" SUB0_STRINGIFY_HELPER(name) "\"\n" \
+        ".asciz \"4@%0 8@%1 8@%2\"\n" \
+        "994: .balign 4\n" \
+        ".popsection\n" \
+        ".ifndef _.stapsdt.base\n" \
+        ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n" \
+        ".weak _.stapsdt.base\n" \
+        ".hidden _.stapsdt.base\n" \
+        "_.stapsdt.base: .space 1\n" \
+        ".size _.stapsdt.base, 1\n" \
+        ".popsection\n" \
+        ".endif\n" \
+        :: "nor"( static_cast<uint32_t>(typeId) ) \
+         , "nor"( reinterpret_cast<uintptr_t>( static_cast<const void*>(data) ) ) \
+         , "nor"( static_cast<uint64_t>(size) ) )
+#else
+#define SUB0_PROBE(name, typeId, data, size) ((void)0)
+#endif
+
 /// @todo Trace interface - currently std::cout only!!
 #if SUB0PUB_TRACE
 #include <iostream>
 #endif
 
+#if SUB0PUB_TRACE_EVENTS
+#include <memory> //< std::unique_ptr
+#include <mutex> //< std::mutex
+#include <vector> //< std::vector
+#endif
+
+/** Enable MessageInfo capture on publish of Data
+ * @note Must be used from the global namespace
+ * @param  Data  Fully qualified Data type e.g. SUB0_MESSAGE_INFO(my::Pose)
+ */
+#define SUB0_MESSAGE_INFO(Data) \
+    namespace sub0 { template<> struct HasMessageInfo<Data> : std::true_type {}; }
+
+/** Retain the last 'depth' publishes of Data for replay to late subscribers @see Subscribe<Data>::replay
+ * @note Must be used from the global namespace
+ * @param  Data  Fully qualified Data type e.g. SUB0_HISTORY(my::Pose, 4)
+ * @param  depth  Count of messages retained
+ */
+#define SUB0_HISTORY(Data, depth) \
+    namespace sub0 { template<> struct HistoryDepth<Data> : std::integral_constant<uint32_t, depth> {}; }
+
 /** Sub0Pub top-level namespace
 */
 namespace sub0
@@ -168,31 +296,80 @@ namespace sub0
             virtual bool isEof() = 0;
         };
 
-// TODO: Need to refactor use of streams!?
-#if SUB0PUB_STD
-        /// @todo Determine how to avoid this i.e. Drop std::istream or only use interface type?
-        inline size_t readline(std::istream& istream, char* const buffer, const size_t bufferCount)
+        /** ByteSink writing into a caller provided memory block
+         * @remark Non-virtual alternative to OStream allowing frame encoding to inline into the serialiser
+         *  e.g. StreamSerializer<Protocol, Protocol::Writer, MemorySink>
+         */
+        class MemorySink
         {
-            return istream.getline(buffer, bufferCount).gcount();
-        }
+        public:
+            MemorySink( char* const buffer, const size_t capacity )
+                : buffer_(buffer), capacity_(capacity), size_(0U)
+            {}
 
-        template< typename Type_t >
-        inline bool write(std::ostream& stream, const Type_t& value)
-        {
-            return stream.write(reinterpret_cast<const char*>(&value), sizeof(value)).good();
-        }
+            /** @return Count of bytes written, less than bufferCount when capacity is reached
+            */
+            size_t write(const char* const buffer, const size_t bufferCount)
+            {
+                const size_t count = std::min(bufferCount, capacity_ - size_);
+                std::memcpy(buffer_ + size_, buffer, count);
+                size_ += count;
+                return count;
+            }
 
-        template< typename Type_t >
-        inline bool write(std::ostream& stream)
+            void flush()
+            {}
+
+            const char* data() const { return buffer_; }
+            size_t size() const { return size_; }
+
+            /** Discard written bytes
+            */
+            void clear() { size_ = 0U; }
+
+        private:
+            char* buffer_;
+            size_t capacity_;
+            size_t size_; ///< Count of bytes written
+        };
+
+        /** ByteSource reading from a memory block
+         * @remark Non-virtual alternative to IStream e.g. StreamDeserializer<Protocol, Protocol::Reader, MemorySource>
+         */
+        class MemorySource
         {
-            const Type_t defaulted;
-            return stream.write(reinterpret_cast<const char*>(&defaulted), sizeof(defaulted)).good();
-        }
+        public:
+            MemorySource( const char* const data, const size_t size )
+                : data_(data), size_(size), position_(0U)
+            {}
 
-        template<>
-        inline bool write<void>(std::ostream& stream)
+            /** @return Count of bytes read, less than bufferCount at the end of the block
+            */
+            size_t read(char* const buffer, const size_t bufferCount)
+            {
+                const size_t count = std::min(bufferCount, size_ - position_);
+                std::memcpy(buffer, data_ + position_, count);
+                position_ += count;
+                return count;
+            }
+
+            bool isEof() const { return position_ == size_; }
+
+            /** Read again from the start of the block
+            */
+            void rewind() { position_ = 0U; }
+
+        private:
+            const char* data_;
+            size_t size_;
+            size_t position_; ///< Count of bytes read
+        };
+
+#if SUB0PUB_STD
+        /// @todo Determine how to avoid this i.e. Drop std::istream or only use interface type?
+        inline size_t readline(std::istream& istream, char* const buffer, const size_t bufferCount)
         {
-            return true;
+            return istream.getline(buffer, bufferCount).gcount();
         }
 #else
         /// @todo Determine how to avoid this i.e. Drop std::istream or only use interface type?
@@ -200,34 +377,67 @@ namespace sub0
         {
             return istream.readline(buffer, bufferCount);
         }
+#endif
 
-        template< typename Type_t >
-        inline bool write(OStream& stream, const Type_t& value)
+        /** Write bytes to a ByteSink
+         * @remark A ByteSink is any type providing `write(const char*, size)` returning the count of bytes written, and
+         *  `flush()` e.g. OStream or MemorySink. std::ostream is supported when SUB0PUB_STD is enabled.
+         */
+        template< typename ByteSink >
+        inline bool write(ByteSink& stream, const char* const buffer, const size_t bufferCount)
         {
-            return stream.write(reinterpret_cast<const char*>(&value), sizeof(value)) == sizeof(value);
+#if SUB0PUB_STD
+            if constexpr (std::is_base_of<std::ostream, ByteSink>::value)
+                return stream.write(buffer, bufferCount).good();
+            else
+#endif
+                return stream.write(buffer, bufferCount) == bufferCount;
         }
 
-        template< typename Type_t >
-        inline bool write(OStream& stream)
+        template< typename Type_t, typename ByteSink >
+        inline bool write(ByteSink& stream, const Type_t& value)
         {
-            const Type_t defaulted;
-            return stream.write(reinterpret_cast<const char*>(&defaulted), sizeof(defaulted)) == sizeof(defaulted);
+            return write(stream, reinterpret_cast<const char*>(&value), sizeof(value));
         }
 
-        template<>
-        inline bool write<void>(OStream& stream)
+        /** Write default constructed Type_t e.g. Delimiters
+         * @note Writes nothing for void Type_t
+         */
+        template< typename Type_t, typename ByteSink >
+        inline bool write(ByteSink& stream)
         {
-            return true;
+            if constexpr (std::is_void<Type_t>::value)
+                return true;
+            else
+            {
+                const Type_t defaulted;
+                return write(stream, reinterpret_cast<const char*>(&defaulted), sizeof(defaulted));
+            }
         }
+
+        /** Read bytes from a ByteSource
+         * @remark A ByteSource is any type providing `read(char*, size)` returning the count of bytes read e.g. IStream
+         *  or MemorySource. std::istream is supported when SUB0PUB_STD is enabled.
+         * @return Count of bytes read
+         */
+        template< typename ByteSource >
+        inline size_t read(ByteSource& stream, char* const buffer, const size_t bufferCount)
+        {
+#if SUB0PUB_STD
+            if constexpr (std::is_base_of<std::istream, ByteSource>::value)
+                return static_cast<size_t>(stream.read(buffer, bufferCount).gcount()); ///< @todo readsome() for async
+            else
 #endif
+                return static_cast<size_t>(stream.read(buffer, bufferCount));
+        }
 
 
 
         template< typename Type_t >
-        constexpr bool sizeOf() { return sizeof(Type_t); }
+        constexpr size_t sizeOf() { return sizeof(Type_t); }
 
         template<>
-        constexpr bool sizeOf<void>() { return 0; }
+        constexpr size_t sizeOf<void>() { return 0; }
 
         template< typename Type_t >
         constexpr void copyTo(char* buffer)
@@ -270,6 +480,88 @@ namespace sub0
         template <class Default, template<class...> class Op, class... Args>
         using detected_or_t = typename detail::detector<Default, void, Op, Args...>::type;
 
+        /** Monotonic nanosecond clock for MessageInfo timestamps
+         * @remark Reads the time-stamp counter when SUB0PUB_TSC is enabled and available, otherwise reads
+         *  std::chrono::steady_clock. The counter is anchored to steady_clock every cAnchorNanoseconds per thread and
+         *  its rate measured over the whole time since the thread's first read, so the rate error falls with uptime
+         *  and never accumulates past one anchor period. Until the first cCalibrationNanoseconds have passed on a
+         *  thread each read is of steady_clock, there is no calibration wait.
+         * @note Timestamps are in the steady_clock epoch so are comparable between processes on the same host
+         */
+        class Clock
+        {
+        public:
+            /** @return Nanoseconds in the std::chrono::steady_clock epoch
+            */
+            static uint64_t now()
+            {
+#if SUB0PUB_HAS_TSC
+                Calibration& calibration = threadCalibration();
+                const uint64_t ticks = __rdtsc();
+                const uint64_t elapsedTicks = ticks - calibration.ticks;
+                if ( elapsedTicks >= calibration.anchorTicks )
+                    return anchor( calibration, ticks );
+                const uint64_t nanoseconds = calibration.nanoseconds + static_cast<uint64_t>( static_cast<double>( elapsedTicks ) * calibration.nanosecondsPerTick );
+                calibration.last = std::max( calibration.last, nanoseconds ); //< Never behind a previous anchor
+                return calibration.last;
+#else
+                return steadyNow();
+#endif
+            }
+
+        private:
+            static uint64_t steadyNow()
+            { return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() ); }
+
+#if SUB0PUB_HAS_TSC
+            static const uint64_t cCalibrationNanoseconds = 2000000U; ///< Shortest span the counter rate is measured over
+            static const uint64_t cAnchorNanoseconds = 1000000U; ///< Period of re-reading steady_clock
+
+            /** Per-thread relation of the time-stamp counter to steady_clock
+            */
+            struct Calibration
+            {
+                uint64_t originTicks; ///< Time-stamp counter at the first read of the thread
+                uint64_t originNanoseconds; ///< steady_clock at 'originTicks'
+                uint64_t ticks; ///< Time-stamp counter at the latest anchor
+                uint64_t nanoseconds; ///< steady_clock at 'ticks'
+                uint64_t anchorTicks; ///< Ticks between anchors, zero until the rate is measured
+                uint64_t last; ///< Latest time returned
+                double nanosecondsPerTick;
+            };
+
+            static Calibration& threadCalibration()
+            {
+                static thread_local Calibration calibration = {};
+                return calibration;
+            }
+
+            /** Read steady_clock at 'ticks' and refine the counter rate over the time since the first read
+             * @return steady_clock nanoseconds
+            */
+            static uint64_t anchor( Calibration& calibration, const uint64_t ticks )
+            {
+                const uint64_t nanoseconds = steadyNow();
+                if ( calibration.originNanoseconds == 0U )
+                {
+                    calibration.originTicks = ticks;
+                    calibration.originNanoseconds = nanoseconds;
+                }
+
+                const uint64_t elapsedNanoseconds = nanoseconds - calibration.originNanoseconds;
+                if ( elapsedNanoseconds >= cCalibrationNanoseconds && ticks != calibration.originTicks )
+                {
+                    calibration.nanosecondsPerTick = static_cast<double>( elapsedNanoseconds ) / static_cast<double>( ticks - calibration.originTicks );
+                    calibration.anchorTicks = static_cast<uint64_t>( static_cast<double>( cAnchorNanoseconds ) / calibration.nanosecondsPerTick );
+                }
+                calibration.ticks = ticks;
+                calibration.nanoseconds = nanoseconds;
+                calibration.last = std::max( calibration.last, nanoseconds );
+                return calibration.last;
+            }
+#endif
+        };
+
     } // END: utility
 
 #if SUB0PUB_STD
@@ -297,128 +589,949 @@ namespace sub0
      */
     template< typename Data >
     class Subscribe;
-    
-    /** Internal configured details for tracing and error handling
+
+    /** Metadata of a published message
+     * @see HasMessageInfo
      */
-    namespace detail
+    struct MessageInfo
     {
-        /** Empty type for optional specialisations e.g. config()
-        */
-        struct Empty {};
+        uint64_t timestamp; ///< Nanoseconds from utility::Clock at publish
+        uint32_t sequence; ///< Per-topic publish count starting from 1, 0 when the message carries no MessageInfo
+    };
 
-        /** Provides debug assertion/exception checks for Broker<>
-         * @see SUB0PUB_TRACE   Enable logging for broker events
-         * @see SUB0PUB_ASSERT   Enable assertion tests for invalid parameters
-         */
-        struct Check
+    /** Report of a receive() that exceeded the LatencyBudget of its topic
+     */
+    struct BudgetOverrun
+    {
+        uint32_t typeId; ///< Broker<Data>::typeId(), 0 unless SUB0PUB_TYPEIDNAME
+        const char* typeName; ///< Broker<Data>::typeName(), nullptr unless SUB0PUB_TYPEIDNAME
+        const void* subscriber; ///< Subscribe<Data> instance whose receive() overran
+        uint64_t elapsedNanoseconds; ///< Duration of the receive()
+        uint64_t budgetNanoseconds; ///< LatencyBudget::nanoseconds exceeded
+        uint32_t suppressedCount; ///< Overruns not reported since the previous report due to rate limiting
+    };
+
+    /** Per-delivery time budget of a topic @see Broker<Data>::setBudget
+     * @remark The callback is called from within publish() on the publishing thread so should be short, it is not
+     *  called more than once per minReportNanoseconds and overruns in-between are counted only
+     */
+    struct LatencyBudget
+    {
+        uint64_t nanoseconds = 0U; ///< Limit of each receive() duration, 0 disables the budget
+        void (*callback)( const BudgetOverrun& overrun, void* context ) = nullptr;
+        void* context = nullptr; ///< Passed to callback
+        uint64_t minReportNanoseconds = 1000000000U; ///< Minimum interval between callbacks
+        bool cancelOnOverrun = false; ///< Cancel remaining deliveries of the publish as Subscribe<Data>::cancel()
+    };
+
+#if SUB0PUB_PROFILE
+    /** Log-bucketed histogram of receive() durations of one subscription
+     * @remark Bucket i counts durations with bit-width i i.e. [2^(i-1), 2^i) nanoseconds
+     * @see SUB0PUB_PROFILE
+     */
+    struct ReceiveProfile
+    {
+        static const uint32_t cBucketCount = 65U;
+
+        uint64_t count; ///< Count of receive() calls
+        uint64_t totalNanoseconds; ///< Sum of receive() durations
+        uint64_t maxNanoseconds; ///< Longest receive() duration
+        uint64_t buckets[cBucketCount];
+
+        void record( const uint64_t nanoseconds )
         {
-            /** Diagnose creation of new subscriber
-             * @param broker  Broker instance that manages the connection
-             * @param subscriber  Subscriber to be registered into the broker
-             * @param subscriptionCount  Count of existing registered subscriptions on the broker
-             * @param subscriptionCapacity  Count specifying subscriptionCount limit for the broker
-             */
-            template<typename Data>
-            inline static void onSubscription( const Broker<Data>& broker, Subscribe<Data>* subscriber, const uint32_t subscriptionCount, const uint32_t subscriptionCapacity )
-            {
-#if SUB0PUB_ASSERT
-                assert( subscriber );
-                assert( subscriptionCount < subscriptionCapacity );
-#endif
-#if SUB0PUB_TRACE /// @todo iostream removal:
-                std::cout << "[Sub0Pub] New Subscription " << *subscriber << " for Broker<" << broker.typeName() << ">{" << broker << '}' << std::endl;
+            uint32_t bitWidth = 0U;
+#if defined(__GNUC__)
+            bitWidth = (nanoseconds != 0U) ? 64U - static_cast<uint32_t>( __builtin_clzll( nanoseconds ) ) : 0U;
+#else
+            for ( uint64_t remaining = nanoseconds; remaining != 0U; remaining >>= 1U )
+                ++bitWidth;
 #endif
-            }
+            ++buckets[bitWidth];
+            ++count;
+            totalNanoseconds += nanoseconds;
+            maxNanoseconds = std::max( maxNanoseconds, nanoseconds );
+        }
 
-            /** Diagnose creation of new publisher
-             * @param publisher  Publisher to be registered into the broker
-             * @param broker  Broker instance that manages the connection
-             * @param publisherCount  Count of existing registered publishers on the broker
-             * @param publisherCapacity  Count specifying publisherCount limit for the broker
-             */
-            template<typename Data>
-            inline static void onPublication( Publish<Data>* publisher, const Broker<Data>& broker, const uint32_t publisherCount, const uint32_t publisherCapacity )
+        /** @return Upper bound in nanoseconds of the bucket holding 'fraction' of calls e.g. 0.99, 0 if no calls
+         */
+        uint64_t percentile( const double fraction ) const
+        {
+            const uint64_t rank = std::max<uint64_t>( 1U, static_cast<uint64_t>( fraction * double(count) + 0.5 ) );
+            uint64_t cumulative = 0U;
+            for ( uint32_t iBucket = 0U; iBucket < cBucketCount && count != 0U; ++iBucket )
             {
-#if SUB0PUB_ASSERT
-                assert( publisher );
-                assert( publisherCount < publisherCapacity );
-#endif
-#if SUB0PUB_TRACE /// @todo iostream removal:
-                std::cout << "[Sub0Pub] New Publication " << *publisher << " for Broker<" << broker.typeName() << ">{" << broker << '}' << std::endl;
-#endif
+                cumulative += buckets[iBucket];
+                if ( cumulative >= rank )
+                    return std::min( (iBucket < 64U) ? (uint64_t(1U) << iBucket) - 1U : UINT64_MAX, maxNanoseconds );
             }
+            return 0U;
+        }
 
-            /** Diagnose data publish event
-             * @param publisher  Publisher that is sending the data
-             * @param data  The data to be published
-             */
-            template<typename Data>
-            inline static void onPublish( const Publish<Data>& publisher, const Data& data )
-            {
-#if SUB0PUB_TRACE /// @todo iostream removal: 
-                    (void)data; ///< @todo Data serialize
-                    std::cout << "[Sub0Pub] Published " << publisher
-                        << " {_data_todo_}"/** @todo Data serialize: << data*/ << '[' << Broker<Data>::typeName() << ']' << std::endl;
-#endif
-            }
+        /** @return Mean receive() duration in nanoseconds
+         */
+        double meanNanoseconds() const
+        { return (count != 0U) ? double(totalNanoseconds) / double(count) : 0.0; }
+    };
 
-            /** Diagnose data receive event
-             * @param subscriber  Subscriber that is receiving the data
-             * @param data  The data that is received
-             */
-             /// @todo GCC 7.2(TBC) publish(const Data & data) bug on inlining this function and calling detail::Check::onReceive()? needs __attribute__((noinline))?
-            template<typename Data>
-            static void onReceive( Subscribe<Data>* subscriber, const Data& data )
-            {
-#if SUB0PUB_ASSERT
-                    assert(subscriber );
-#endif
-#if SUB0PUB_TRACE /// @todo iostream removal: 
-                    (void)data; ///< @todo Data serialize
-                    std::cout << "[Sub0Pub] Received " << *subscriber
-                        << " {_data_todo_}"/** @todo Data serialize: << data*/ << '[' << Broker<Data>::typeName() << ']' << std::endl;
+    /** ReceiveProfile of a subscriber @see Broker<Data>::slowestSubscribers
+     */
+    struct SubscriberProfile
+    {
+        const void* subscriber; ///< Subscribe<Data> instance
+        ReceiveProfile profile;
+    };
 #endif
-            }
-        };
 
-    } // END: detail
+    /** Enables capture of MessageInfo on publish of 'Data'
+     * @remark Enable for a type with SUB0_MESSAGE_INFO(Data), topics that are not enabled pay nothing
+     * @tparam Data  Data type which MessageInfo is captured for
+     */
+    template< typename Data >
+    struct HasMessageInfo : std::false_type {};
 
-    /** Base type for an object that subscribes to some strong-typed Data
-     * @tparam  Data  Type that will be received from publishers of corresponding type
+    /** Count of the latest publishes of 'Data' retained by Broker<Data> for replay
+     * @remark Enable for a type with SUB0_HISTORY(Data, depth), publish then copies each message into a fixed ring
+     *  and topics without history pay nothing
+     * @tparam Data  Data type which publishes are retained for
      */
     template< typename Data >
-    class Subscribe
+    struct HistoryDepth : std::integral_constant<uint32_t, 0U> {};
+    
+#if SUB0PUB_TRACE_EVENTS
+    /** Boundary of a publish or receive span @see SUB0PUB_TRACE_EVENTS
+     */
+    struct TraceEvent
+    {
+        enum Phase : uint8_t
+        {
+            PublishBegin,
+            PublishEnd,
+            ReceiveBegin, ///< Begin of Subscribe<Data>::filter() and receive()
+            ReceiveEnd
+        };
+
+        uint64_t timestamp; ///< Nanoseconds from utility::Clock
+        const void* object; ///< Publish<Data> or Subscribe<Data> instance
+        const char* typeName; ///< Broker<Data>::typeName(), nullptr unless SUB0PUB_TYPEIDNAME
+        uint32_t typeId; ///< Broker<Data>::typeId(), 0 unless SUB0PUB_TYPEIDNAME
+        uint32_t flowId; ///< Publish the event belongs to, unique within the TraceBuffer
+        Phase phase;
+    };
+
+    /** Ring of the most recent TraceEvent of one thread
+     * @remark Written only by its thread without locking, read once recording is stopped @see TraceSession
+     */
+    class TraceBuffer
     {
     public:
-        /** Registers the subscriber within the broker framework
-         * @param[in] typeName Optional unique data name given to data for inter-process signalling. @warning If not supplied non-portable compiler generated names 'may' be used.
-         */
-        Subscribe( 
-#if SUB0PUB_TYPEIDNAME
-            const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/ 
-#endif
-        )
-        : broker_( this
-#if SUB0PUB_TYPEIDNAME
-            , typeId, typeName 
-#endif
-        )
+        static const uint32_t cCapacity = 1U << 16U; ///< Events retained, older events are overwritten
+        static const uint32_t cMaxDepth = 32U; ///< Nesting limit of publish from within receive()
+
+    public:
+        explicit TraceBuffer( const uint32_t threadIndex )
+            : events_( new TraceEvent[cCapacity] ), count_( 0U ), threadIndex_( threadIndex ), flowCount_( 0U ), depth_( 0U )
         {}
 
-        virtual ~Subscribe()
-        {  broker_.unsubscribe(this); } ///< @todo Make implicit broker handle
-        
-        /** Receive published Data
-         * @remark Data is published from Publish<Data>::publish
+        void record( const TraceEvent::Phase phase, const void* const object, const uint32_t typeId, const char* const typeName )
+        {
+            if ( phase == TraceEvent::PublishBegin )
+            {
+                ++flowCount_;
+                if ( depth_ < cMaxDepth )
+                    flows_[depth_] = flowCount_;
+                ++depth_;
+            }
+
+            const uint32_t flowId = (depth_ == 0U) ? 0U : flows_[((depth_ < cMaxDepth) ? depth_ : cMaxDepth) - 1U];
+            events_[count_ % cCapacity] = TraceEvent{ utility::Clock::now(), object, typeName, typeId, flowId, phase };
+            ++count_;
+
+            if ( phase == TraceEvent::PublishEnd && depth_ != 0U )
+                --depth_;
+        }
+
+        /** @return Index of the thread in order of first recorded event
+         */
+        uint32_t threadIndex() const
+        { return threadIndex_; }
+
+        /** @return Count of retained events
+         */
+        size_t size() const
+        { return static_cast<size_t>( std::min<uint64_t>( count_, cCapacity ) ); }
+
+        /** @return Retained event 'index' in recorded order
+         */
+        const TraceEvent& operator[]( const size_t index ) const
+        { return events_[(count_ - size() + index) % cCapacity]; }
+
+        void clear()
+        { count_ = 0U; }
+
+    private:
+        std::unique_ptr<TraceEvent[]> events_;
+        uint64_t count_; ///< Count of events recorded
+        uint32_t threadIndex_;
+        uint32_t flowCount_; ///< Count of publishes recorded
+        uint32_t flows_[cMaxDepth]; ///< Flow of each nested publish in progress
+        uint32_t depth_; ///< Count of nested publishes in progress
+    };
+
+    /** Process-wide control of span recording and the TraceBuffer of each thread
+     * @remark Recording is stopped initially. A thread allocates its TraceBuffer on its first event after start().
+     */
+    class TraceSession
+    {
+    public:
+        /** Begin recording
+         */
+        static void start()
+        { state().recording.store( true, std::memory_order_release ); }
+
+        /** Stop recording, buffers may be read once threads have finished any publish in progress
+         */
+        static void stop()
+        { state().recording.store( false, std::memory_order_release ); }
+
+        static bool isRecording()
+        { return state().recording.load( std::memory_order_relaxed ); }
+
+        /** Discard recorded events of all threads
+         */
+        static void clear()
+        {
+            std::lock_guard<std::mutex> lock( state().mutex );
+            for ( const std::unique_ptr<TraceBuffer>& buffer : state().buffers )
+                buffer->clear();
+        }
+
+        /** Call 'visitor(const TraceBuffer&)' for the buffer of each thread that has recorded
+         */
+        template< typename Visitor >
+        static void visit( Visitor&& visitor )
+        {
+            std::lock_guard<std::mutex> lock( state().mutex );
+            for ( const std::unique_ptr<TraceBuffer>& buffer : state().buffers )
+                visitor( *buffer );
+        }
+
+        /** Record an event into the buffer of the calling thread
+         */
+        static void record( const TraceEvent::Phase phase, const void* const object, const uint32_t typeId, const char* const typeName )
+        {
+            if ( isRecording() )
+                local().record( phase, object, typeId, typeName );
+        }
+
+    private:
+        struct State
+        {
+            std::atomic<bool> recording{ false };
+            std::mutex mutex; ///< Guards buffers
+            std::vector< std::unique_ptr<TraceBuffer> > buffers; ///< Buffer of each thread, outliving the thread
+        };
+
+        static State& state()
+        {
+            static State session;
+            return session;
+        }
+
+        static TraceBuffer& local()
+        {
+            static thread_local TraceBuffer* buffer = nullptr;
+            if ( buffer == nullptr )
+            {
+                std::lock_guard<std::mutex> lock( state().mutex );
+                state().buffers.emplace_back( new TraceBuffer( static_cast<uint32_t>( state().buffers.size() ) ) );
+                buffer = state().buffers.back().get();
+            }
+            return *buffer;
+        }
+    };
+#endif
+
+#if SUB0PUB_CAUSALITY
+    /** Causal identity of a publish @see SUB0PUB_CAUSALITY
+     */
+    struct SpanContext
+    {
+        uint64_t traceId; ///< Shared by the root publish of a chain and all publishes caused by it, 0 for no span
+        uint64_t spanId; ///< Unique to each publish
+        uint64_t parentSpanId; ///< spanId of the publish being delivered when this was published, 0 for a root
+    };
+
+    /** Completed delivery of a publish @see Causality::setObserver
+     */
+    struct SpanRecord
+    {
+        SpanContext context;
+        uint32_t typeId; ///< Broker<Data>::typeId(), 0 unless SUB0PUB_TYPEIDNAME
+        const char* typeName; ///< Broker<Data>::typeName(), nullptr unless SUB0PUB_TYPEIDNAME
+        uint64_t begin; ///< utility::Clock time delivery started
+        uint64_t end; ///< utility::Clock time delivery to all subscribers completed
+    };
+
+    /** Thread-local propagation of SpanContext from a publish to the publishes made during its delivery
+     * @remark Each Broker<Data>::publish starts a span that is a child of current(), or the root of a new trace when
+     *  published outside of a delivery, whose traceId is the spanId of the root. Ids count up from a random per-thread
+     *  seed so need no synchronisation and are unlikely to collide between threads or processes.
+     */
+    class Causality
+    {
+    public:
+        typedef void (*Observer)( const SpanRecord& span, void* context );
+
+        /** Adopts a SpanContext as the parent of publishes made during its lifetime
+         * @remark Carries causality across a thread or process hop e.g. capture current() with an item pushed into a
+         *  queue and hold a Scope while the consumer publishes it. Used by CausalityBufferRegister for each frame.
+         */
+        class Scope
+        {
+        public:
+            explicit Scope( const SpanContext& parent )
+                : previous_( threadState().current )
+            { threadState().current = parent; }
+
+            ~Scope()
+            { threadState().current = previous_; }
+
+            Scope( const Scope& ) = delete;
+            Scope& operator=( const Scope& ) = delete;
+
+        private:
+            SpanContext previous_;
+        };
+
+        /** @return SpanContext of the message being delivered on the calling thread, zeroed outside of delivery
+         */
+        static const SpanContext& current()
+        { return threadState().current; }
+
+        /** Set the callback of each completed span, nullptr to disable
+         * @remark Called on the publishing thread once delivery to all subscribers completes, so nested spans are
+         *  reported before their parent. Span times are only read while an observer is set.
+         * @note Not thread-safe against concurrent publish
+         */
+        static void setObserver( const Observer observer, void* const context )
+        {
+            observerState().callback = observer;
+            observerState().context = context;
+        }
+
+    private:
+        template< typename Data >
+        friend class Broker;
+
+        /** Span of a publish in progress
+         */
+        struct Span
+        {
+            SpanContext parent; ///< current() restored when the span ends
+            uint64_t begin; ///< utility::Clock time of enter(), 0 without an observer
+        };
+
+        struct ObserverState
+        {
+            Observer callback;
+            void* context;
+        };
+
+        struct ThreadState
+        {
+            SpanContext current;
+            uint64_t nextId; ///< Id of the next span, 0 until seeded
+        };
+
+        /** Start the span of a publish as a child of current()
+         */
+        static Span enter()
+        {
+            ThreadState& state = threadState();
+            if ( state.nextId == 0U )
+                state.nextId = seed(); //< First span of the thread, or the ids wrapped
+
+            const Span span = { state.current, (observerState().callback != nullptr) ? utility::Clock::now() : 0U };
+            state.current.spanId = state.nextId++;
+            state.current.traceId = (span.parent.traceId != 0U) ? span.parent.traceId : state.current.spanId;
+            state.current.parentSpanId = span.parent.spanId;
+            return span;
+        }
+
+        /** End the span started by enter() and restore its parent as current()
+         */
+        static void leave( const Span& span, const uint32_t typeId, const char* const typeName )
+        {
+            SpanContext& current = threadState().current;
+            const ObserverState& observer = observerState();
+            if ( observer.callback != nullptr )
+            {
+                const SpanRecord record = { current, typeId, typeName, span.begin, utility::Clock::now() };
+                observer.callback( record, observer.context );
+            }
+            current = span.parent;
+        }
+
+        /** @return Non-zero random id mixed from the clock and the address of the thread state
+         */
+        static uint64_t seed()
+        {
+            uint64_t value = utility::Clock::now() ^ reinterpret_cast<uintptr_t>( &threadState() );
+            value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL; //< splitmix64 finaliser
+            value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+            return (value ^ (value >> 31U)) | 1U;
+        }
+
+        static ThreadState& threadState()
+        {
+            static thread_local ThreadState state = {};
+            return state;
+        }
+
+        static ObserverState& observerState()
+        {
+            static ObserverState observer = {};
+            return observer;
+        }
+    };
+#endif
+
+#if SUB0PUB_STATS
+    /** Counters of one topic within a StatsLayout
+     * @remark Counters are written by the publishing thread with relaxed atomic loads and stores rather than
+     *  read-modify-write, so publishes of the same Data from several threads at once may lose counts
+     */
+    struct alignas(64) StatsTopic
+    {
+        static const uint32_t cNameSize = 64U;
+        static const uint32_t cLatencyBucketCount = 32U; ///< Bucket i counts durations of bit-width i nanoseconds, the last is open-ended
+
+        char typeName[cNameSize]; ///< Null-terminated, truncated @see BrokerInfo::typeName
+        uint32_t typeId; ///< Broker<Data>::typeId(), 0 unless SUB0PUB_TYPEIDNAME
+        uint32_t dataBytes; ///< sizeof(Data)
+        std::atomic<uint32_t> subscriberCount; ///< Current count of Subscribe<Data>
+        std::atomic<uint64_t> publishCount; ///< Count of Broker<Data>::publish
+        std::atomic<uint64_t> deliveryCount; ///< Count of receive() calls
+        std::atomic<uint64_t> dropCount; ///< Count of subscribers skipped by filter() or cancel()
+        std::atomic<uint64_t> latencyBuckets[cLatencyBucketCount]; ///< Duration of delivery of each publish to all subscribers
+    };
+
+    /** Fixed layout of the counters of all topics, shareable between processes of the same architecture
+     */
+    struct StatsLayout
+    {
+        static const uint32_t cMagic = utility::FourCC<'S', '0', 'S', 'T'>::value;
+        static const uint32_t cVersion = 1U;
+        static const uint32_t cMaxTopics = 256U; ///< Topics beyond the limit are counted into an unlisted overflow slot
+
+        uint32_t magic; ///< cMagic once initialised
+        uint32_t version; ///< cVersion
+        uint32_t processId; ///< Process updating the counters, 0 if unknown
+        std::atomic<uint32_t> topicCount; ///< Count of listed topics, stored with release once every slot below it is described
+        StatsTopic topics[cMaxTopics + 1U]; ///< Listed topics followed by the overflow slot
+    };
+
+    /** Process-wide StatsLayout updated by Broker<Data>::publish @see SUB0PUB_STATS
+     * @remark Counters are kept in process memory until attach() moves them into another layout e.g. a shared-memory
+     *  page created by StatsPage. Updating a counter needs no lock or system call.
+     */
+    class Stats
+    {
+    public:
+        static_assert( std::atomic<uint64_t>::is_always_lock_free, "StatsLayout requires lock-free 64-bit atomics to be shared" );
+
+        /** Move counters into 'layout' and update it from then on
+         * @param layout  Zeroed layout, which must outlive the attachment
+         * @param processId  Recorded into StatsLayout::processId
+         * @note Attach before publishing from other threads, counts made during the move may be lost
+         */
+        static void attach( StatsLayout& layout, const uint32_t processId )
+        {
+            StatsLayout& previous = *state().load( std::memory_order_relaxed );
+            copy( layout, previous );
+            layout.processId = processId;
+            layout.version = StatsLayout::cVersion;
+            layout.magic = StatsLayout::cMagic;
+            state().store( &layout, std::memory_order_release );
+        }
+
+        /** Move counters back into process memory, e.g. before the attached layout is unmapped
+         */
+        static void detach()
+        {
+            StatsLayout& previous = *state().load( std::memory_order_relaxed );
+            if ( &previous == &local() )
+                return;
+            copy( local(), previous );
+            state().store( &local(), std::memory_order_release );
+        }
+
+        /** @return Layout being updated
+         */
+        static const StatsLayout& layout()
+        { return *state().load( std::memory_order_acquire ); }
+
+    private:
+        template< typename Data >
+        friend class Broker;
+
+        /** Reserve the slot of a topic, to be described then made visible by list()
+         * @return Index of the topic's slot, the overflow slot when StatsLayout::cMaxTopics are reserved
+         */
+        static uint32_t reserve()
+        {
+            const uint32_t index = reservations().count.fetch_add( 1U, std::memory_order_relaxed );
+            return (index < StatsLayout::cMaxTopics) ? index : StatsLayout::cMaxTopics;
+        }
+
+        /** Make the described slot at 'index' visible to readers
+         * @remark topicCount is advanced over every described slot from its current value, so a slot described before
+         *  a lower slot of a concurrent reservation is made visible by the list() of the lower slot
+         */
+        static void list( const uint32_t index )
+        {
+            if ( index == StatsLayout::cMaxTopics )
+                return;
+
+            Reservations& reserved = reservations();
+            reserved.described[index].store( true ); //< Sequentially consistent with the loads of a concurrent list()
+            std::atomic<uint32_t>& topicCount = state().load( std::memory_order_relaxed )->topicCount;
+            for ( uint32_t count = topicCount.load(); count < StatsLayout::cMaxTopics && reserved.described[count].load(); )
+            {
+                if ( topicCount.compare_exchange_weak( count, count + 1U ) )
+                    ++count;
+            }
+        }
+
+        /** Set the type description of a slot
+         */
+        static void describe( const uint32_t index, const uint32_t typeId, const char* const typeName, const uint32_t dataBytes )
+        {
+            StatsTopic& slot = topic( index );
+            slot.typeId = typeId;
+            slot.dataBytes = dataBytes;
+            size_t length = 0U;
+            while ( length + 1U < StatsTopic::cNameSize && typeName[length] != '\0' )
+                ++length;
+            std::memcpy( slot.typeName, typeName, length );
+            slot.typeName[length] = '\0';
+        }
+
+        static StatsTopic& topic( const uint32_t index )
+        { return state().load( std::memory_order_relaxed )->topics[index]; }
+
+        static void increment( std::atomic<uint64_t>& counter, const uint64_t count )
+        { counter.store( counter.load( std::memory_order_relaxed ) + count, std::memory_order_relaxed ); }
+
+        /** Record 'publishes' messages published together into the slot at 'index'
+         * @remark The latency of a batch is recorded as its mean per message
+         */
+        static void record( const uint32_t index, const uint32_t publishes, const uint32_t deliveries, const uint32_t drops, uint64_t nanoseconds )
+        {
+            StatsTopic& slot = topic( index );
+            nanoseconds /= publishes;
+            uint32_t bitWidth = 0U;
+#if defined(__GNUC__)
+            bitWidth = (nanoseconds != 0U) ? 64U - static_cast<uint32_t>( __builtin_clzll( nanoseconds ) ) : 0U;
+#else
+            for ( uint64_t remaining = nanoseconds; remaining != 0U; remaining >>= 1U )
+                ++bitWidth;
+#endif
+            increment( slot.publishCount, publishes );
+            increment( slot.deliveryCount, deliveries );
+            increment( slot.dropCount, drops );
+            increment( slot.latencyBuckets[(bitWidth < StatsTopic::cLatencyBucketCount) ? bitWidth : StatsTopic::cLatencyBucketCount - 1U], publishes );
+        }
+
+        static void copy( StatsLayout& to, const StatsLayout& from )
+        {
+            const uint32_t count = from.topicCount.load( std::memory_order_acquire );
+            for ( uint32_t iTopic = 0U; iTopic <= StatsLayout::cMaxTopics; ++iTopic )
+            {
+                StatsTopic& target = to.topics[iTopic];
+                const StatsTopic& source = from.topics[iTopic];
+                std::memcpy( target.typeName, source.typeName, sizeof(target.typeName) );
+                target.typeId = source.typeId;
+                target.dataBytes = source.dataBytes;
+                target.subscriberCount.store( source.subscriberCount.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+                target.publishCount.store( source.publishCount.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+                target.deliveryCount.store( source.deliveryCount.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+                target.dropCount.store( source.dropCount.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+                for ( uint32_t iBucket = 0U; iBucket < StatsTopic::cLatencyBucketCount; ++iBucket )
+                    target.latencyBuckets[iBucket].store( source.latencyBuckets[iBucket].load( std::memory_order_relaxed ), std::memory_order_relaxed );
+            }
+            to.topicCount.store( count, std::memory_order_release );
+        }
+
+        /** Slots reserved by this process
+         */
+        struct Reservations
+        {
+            std::atomic<uint32_t> count; ///< Count of reserve() calls
+            std::atomic<bool> described[StatsLayout::cMaxTopics]; ///< Slot is described and may be listed
+        };
+
+        static Reservations& reservations()
+        {
+            static Reservations reserved; //< Zero initialised
+            return reserved;
+        }
+
+        static StatsLayout& local()
+        {
+            static StatsLayout layout; //< Zero initialised
+            return layout;
+        }
+
+        static std::atomic<StatsLayout*>& state()
+        {
+            static std::atomic<StatsLayout*> layout{ &local() };
+            return layout;
+        }
+    };
+#endif
+
+    /** Internal configured details for tracing and error handling
+     */
+    namespace detail
+    {
+        /** Empty type for optional specialisations e.g. config()
+        */
+        struct Empty {};
+
+        /** Provides debug assertion/exception checks for Broker<>
+         * @see SUB0PUB_TRACE   Enable logging for broker events
+         * @see SUB0PUB_ASSERT   Enable assertion tests for invalid parameters
+         */
+        struct Check
+        {
+            /** Diagnose creation of new subscriber
+             * @param broker  Broker instance that manages the connection
+             * @param subscriber  Subscriber to be registered into the broker
+             * @param subscriptionCount  Count of existing registered subscriptions on the broker
+             * @param subscriptionCapacity  Count specifying subscriptionCount limit for the broker
+             */
+            template<typename Data>
+            inline static void onSubscription( const Broker<Data>& broker, Subscribe<Data>* subscriber, const uint32_t subscriptionCount, const uint32_t subscriptionCapacity )
+            {
+#if SUB0PUB_ASSERT
+                assert( subscriber );
+                assert( subscriptionCount < subscriptionCapacity );
+#endif
+#if SUB0PUB_TRACE /// @todo iostream removal:
+                std::cout << "[Sub0Pub] New Subscription " << *subscriber << " for Broker<" << broker.typeName() << ">{" << broker << '}' << std::endl;
+#endif
+            }
+
+            /** Diagnose creation of new publisher
+             * @param publisher  Publisher to be registered into the broker
+             * @param broker  Broker instance that manages the connection
+             * @param publisherCount  Count of existing registered publishers on the broker
+             * @param publisherCapacity  Count specifying publisherCount limit for the broker
+             */
+            template<typename Data>
+            inline static void onPublication( Publish<Data>* publisher, const Broker<Data>& broker, const uint32_t publisherCount, const uint32_t publisherCapacity )
+            {
+#if SUB0PUB_ASSERT
+                assert( publisher );
+                assert( publisherCount < publisherCapacity );
+#endif
+#if SUB0PUB_TRACE /// @todo iostream removal:
+                std::cout << "[Sub0Pub] New Publication " << *publisher << " for Broker<" << broker.typeName() << ">{" << broker << '}' << std::endl;
+#endif
+            }
+
+            /** Diagnose data publish event
+             * @param publisher  Publisher that is sending the data
+             * @param data  The data to be published
+             */
+            template<typename Data>
+            inline static void onPublish( const Publish<Data>& publisher, const Data& data )
+            {
+#if SUB0PUB_TRACE_EVENTS
+                record<Data>( TraceEvent::PublishBegin, &publisher );
+#endif
+#if SUB0PUB_TRACE /// @todo iostream removal: 
+                    (void)data; ///< @todo Data serialize
+                    std::cout << "[Sub0Pub] Published " << publisher
+                        << " {_data_todo_}"/** @todo Data serialize: << data*/ << '[' << Broker<Data>::typeName() << ']' << std::endl;
+#endif
+            }
+
+            /** Diagnose data receive event
+             * @param subscriber  Subscriber that is receiving the data
+             * @param data  The data that is received
+             */
+             /// @todo GCC 7.2(TBC) publish(const Data & data) bug on inlining this function and calling detail::Check::onReceive()? needs __attribute__((noinline))?
+            template<typename Data>
+            static void onReceive( Subscribe<Data>* subscriber, const Data& data )
+            {
+#if SUB0PUB_TRACE_EVENTS
+                record<Data>( TraceEvent::ReceiveBegin, subscriber );
+#endif
+#if SUB0PUB_ASSERT
+                    assert(subscriber );
+#endif
+#if SUB0PUB_TRACE /// @todo iostream removal: 
+                    (void)data; ///< @todo Data serialize
+                    std::cout << "[Sub0Pub] Received " << *subscriber
+                        << " {_data_todo_}"/** @todo Data serialize: << data*/ << '[' << Broker<Data>::typeName() << ']' << std::endl;
+#endif
+            }
+
+            /** Diagnose completion of data publish to all subscribers
+             * @param publisher  Publisher that sent the data
+             * @param data  The data that was published
+             */
+            template<typename Data>
+            inline static void onPublished( const Publish<Data>& publisher, const Data& data )
+            {
+#if SUB0PUB_TRACE_EVENTS
+                record<Data>( TraceEvent::PublishEnd, &publisher );
+#endif
+            }
+
+            /** Diagnose completion of data receive including filter()
+             * @param subscriber  Subscriber that received the data
+             * @param data  The data that was received
+             */
+            template<typename Data>
+            inline static void onReceived( Subscribe<Data>* subscriber, const Data& data )
+            {
+#if SUB0PUB_TRACE_EVENTS
+                record<Data>( TraceEvent::ReceiveEnd, subscriber );
+#endif
+            }
+
+#if SUB0PUB_TRACE_EVENTS
+        private:
+            template<typename Data>
+            inline static void record( const TraceEvent::Phase phase, const void* const object )
+            {
+#if SUB0PUB_TYPEIDNAME
+                TraceSession::record( phase, object, Broker<Data>::typeId(), Broker<Data>::typeName() );
+#else
+                TraceSession::record( phase, object, 0U, nullptr );
+#endif
+            }
+#endif
+        };
+
+        /** Get the compiler-generated name of a type for diagnostics
+         * @warning Names are non-portable between vendors, "?" where the compiler is not recognised
+         * @return Null-terminated name e.g. "my::Pose", truncated to 127 characters
+         */
+        template<typename Data>
+        const char* compilerTypeName()
+        {
+            static char name[128] = {};
+            if ( name[0] == '\0' )
+            {
+                const char* begin = nullptr;
+                size_t count = 0U;
+#if defined(_MSC_VER) && !defined(__clang__)
+                const char* const signature = __FUNCSIG__; //< "const char *__cdecl sub0::detail::compilerTypeName<struct my::Pose>(void)"
+                begin = std::strstr( signature, "compilerTypeName<" );
+                const char* const end = std::strrchr( signature, '>' );
+                if ( begin != nullptr && end != nullptr )
+                {
+                    begin += std::strlen( "compilerTypeName<" );
+                    count = static_cast<size_t>( end - begin );
+                }
+#elif defined(__GNUC__)
+                const char* const signature = __PRETTY_FUNCTION__; //< "const char* sub0::detail::compilerTypeName() [with Data = my::Pose]"
+                begin = std::strstr( signature, "Data = " );
+                if ( begin != nullptr )
+                {
+                    begin += std::strlen( "Data = " );
+                    count = std::strcspn( begin, ";]" );
+                }
+#endif
+                if ( begin == nullptr || count == 0U )
+                {
+                    begin = "?";
+                    count = 1U;
+                }
+                count = (count < sizeof(name) - 1U) ? count : sizeof(name) - 1U;
+                std::memcpy( name, begin, count );
+                name[count] = '\0';
+            }
+            return name;
+        }
+
+        /** @return Address of the most-derived object of a polymorphic base where RTTI is enabled, otherwise the base
+         */
+        template<typename Base>
+        const void* mostDerived( const Base* const object )
+        {
+#if defined(__cpp_rtti) || defined(__GXX_RTTI) || defined(_CPPRTTI)
+            return dynamic_cast<const void*>( object );
+#else
+            return object;
+#endif
+        }
+
+        /** Retained message with the MessageInfo it was published with
+         */
+        template< typename Data, bool cHasMessageInfo = HasMessageInfo<Data>::value >
+        struct HistoryEntry
+        {
+            Data data;
+            MessageInfo info;
+        };
+
+        template< typename Data >
+        struct HistoryEntry<Data, false>
+        {
+            Data data;
+        };
+
+        /** Fixed-capacity ring of the latest publishes of Data @see HistoryDepth
+         * @tparam cDepth  Count of messages retained
+         */
+        template< typename Data, uint32_t cDepth = HistoryDepth<Data>::value >
+        class History
+        {
+        public:
+            /** Retain 'data', overwriting the oldest message once full
+             */
+            void record( const Data& data, const MessageInfo& info )
+            {
+                HistoryEntry<Data>& entry = entries_[recorded_ % cDepth];
+                entry.data = data;
+                if constexpr ( HasMessageInfo<Data>::value )
+                    entry.info = info;
+                ++recorded_;
+                count_ += (count_ < cDepth) ? 1U : 0U;
+            }
+
+            /** @return Count of retained messages
+             */
+            uint32_t size() const
+            { return count_; }
+
+            /** @return Count of messages ever recorded, the position after the newest retained message
+             */
+            uint64_t recorded() const
+            { return recorded_; }
+
+            /** @return Retained message at 'position' in [recorded() - size(), recorded()), nullptr if overwritten
+             */
+            const HistoryEntry<Data>* find( const uint64_t position ) const
+            {
+                if ( position >= recorded_ || recorded_ - position > count_ )
+                    return nullptr;
+                return &entries_[position % cDepth];
+            }
+
+            void clear()
+            { count_ = 0U; }
+
+        private:
+            HistoryEntry<Data> entries_[cDepth] = {};
+            uint64_t recorded_ = 0U; ///< Count of records, the next is stored at recorded_ % cDepth
+            uint32_t count_ = 0U; ///< Count of occupied slots
+        };
+
+        /** Empty history of Data without SUB0_HISTORY
+         */
+        template< typename Data >
+        class History<Data, 0U>
+        {
+        public:
+            void record( const Data&, const MessageInfo& )
+            {}
+
+            uint32_t size() const
+            { return 0U; }
+
+            void clear()
+            {}
+        };
+
+    } // END: detail
+
+    /** Base type for an object that subscribes to some strong-typed Data
+     * @tparam  Data  Type that will be received from publishers of corresponding type
+     */
+    template< typename Data >
+    class Subscribe
+    {
+    public:
+        /** Registers the subscriber within the broker framework
+         * @param[in] typeName Optional unique data name given to data for inter-process signalling. @warning If not supplied non-portable compiler generated names 'may' be used.
+         */
+        Subscribe( 
+#if SUB0PUB_TYPEIDNAME
+            const uint32_t typeId = 0, const char* typeName = 0/*nullptr*/ 
+#endif
+        )
+        : broker_( this
+#if SUB0PUB_TYPEIDNAME
+            , typeId, typeName 
+#endif
+        )
+        {}
+
+        virtual ~Subscribe()
+        {  broker_.unsubscribe(this); } ///< @todo Make implicit broker handle
+        
+        /** Receive published Data
+         * @remark Data is published from Publish<Data>::publish
          */
         virtual void receive( const Data& data ) = 0;
 
         virtual bool filter(const Data& data)
         {  return true; }
 
+        /** Receive a batch of published Data
+         * @remark Data is published from Publish<Data>::publish( data, count ). By default each element passes filter()
+         *  and receive() in turn. cancel() from either ends the batch at that element, no further elements are received
+         *  and later subscribers receive only those before it. Override to process the batch at once e.g. @see
+         *  reduce.hpp, each element then counts as received and cancel() ends the whole batch for later subscribers.
+         * @param data  Elements published in order
+         * @param count  Count of elements in 'data', never zero
+         */
+        virtual void receiveBatch( const Data* const data, const size_t count )
+        {
+            size_t received = 0U;
+            for ( size_t iData = 0U; iData < count; ++iData )
+            {
+                if ( filter( data[iData] ) )
+                {
+                    receive( data[iData] );
+                    ++received;
+                }
+                if ( broker_.isCanceled() )
+                {
+                    broker_.endBatch( received, iData );
+                    return;
+                }
+            }
+            broker_.endBatch( received, count );
+        }
+
         inline void cancel()
         { broker_.cancel(); }
 
+        /** Deliver the publishes retained by SUB0_HISTORY to this subscriber only, oldest first
+         * @remark Call once the subscriber is fully constructed e.g. at the end of the derived constructor, so a late
+         *  subscriber starts from the current state without a request to its producers. Messages pass filter() and
+         *  cancel() ends the replay. messageInfo() is that of the original publish where HasMessageInfo. Each retained
+         *  message is received at most once, in order, those overwritten by a publish from receive() are skipped.
+         * @return Count of messages received
+         */
+        uint32_t replay()
+        { return broker_.replay( this ); }
+
+        /** Get metadata of the message being received
+         * @remark Only valid from within receive() or filter()
+         * @return MessageInfo of the publish, zeroed when the publish carried none @see HasMessageInfo
+         */
+        const MessageInfo& messageInfo() const
+        { return Broker<Data>::messageInfo(); }
+
 #if SUB0PUB_TYPEIDNAME
         /** Get name identifier of the Data from the broker
          * @return Broker null-terminated type name
@@ -426,45 +1539,463 @@ namespace sub0
         const char* typeName() const
         { return broker_.typeName(); }
 
-        /** Stream operator for diagnostics reporting
-         * @param stream  Stream to report into
-         * @param subscriber  Subscriber instance to be written into stream
-         * @return Reference to 'stream'
+        /** Stream operator for diagnostics reporting
+         * @param stream  Stream to report into
+         * @param subscriber  Subscriber instance to be written into stream
+         * @return Reference to 'stream'
+         */
+        friend OStream& operator<< ( OStream& stream, const Subscribe<Data>& subscriber )
+        { return stream << subscriber.typeName() << '{' << (void*)&subscriber << '}'; }
+#endif
+
+    private:
+        Broker<Data> broker_; ///< MonoState broker instance to manage publish-subscribe connections
+    };
+
+
+    /**  Subscribe to many
+    * @todo Specialisation on std::tuple exists and could cause unexpected expansion if this was a desired type being published!
+    */
+    template< typename... Datas >
+    class SubscribeAll : public Subscribe<Datas>... 
+    {
+    public:
+        static constexpr size_t Count = sizeof...(Datas);
+    };
+
+    /**  Subscribe to many defined by std::tuple type list
+    */
+    template<typename... Datas>
+    class SubscribeAll<std::tuple<Datas...>> : public Subscribe<Datas>...
+    {
+    public:
+        static constexpr size_t Count = sizeof...(Datas);
+    };
+
+    /** Subscribe to many defined by multiple std::tuple type i.e. SubscribeAll< std::tuple<A,B>, std::tuple<B,C> >
+    */
+    template<typename... Datas, typename... OtherTuples>
+    class SubscribeAll<std::tuple<Datas...>, OtherTuples...> 
+        : public SubscribeAll< decltype(std::tuple_cat( std::declval<std::tuple<Datas...>>(), std::declval<OtherTuples>()...)) >
+    {};
+
+    /** Base type for an object that subscribes to every Data type as raw bytes
+     * @remark Wildcard subscription for generic recorders, bridges and inspectors that cannot name each Data type.
+     *  Receives every Broker<Data>::publish ahead of typed subscribers, publishes cost a null check while no wildcard
+     *  is subscribed. Wildcard subscribers are not filtered or cancelled by typed subscribers.
+     * @note typeId is 0 unless SUB0PUB_TYPEIDNAME is enabled and an Id is given for the Data
+     */
+    class SubscribeAny
+    {
+    public:
+        /** Registers the subscriber to receive all published Data
+         */
+        SubscribeAny()
+            : next_( head() )
+        { head() = this; }
+
+        virtual ~SubscribeAny()
+        {
+            SubscribeAny** iRemove = &head();
+            while ( *iRemove != this )
+                iRemove = &(*iRemove)->next_;
+            *iRemove = next_;
+        }
+
+        SubscribeAny( const SubscribeAny& ) = delete;
+        SubscribeAny& operator=( const SubscribeAny& ) = delete;
+
+        /** Receive published Data
+         * @param typeId  Broker<Data>::typeId() of the published Data
+         * @param data  Published Data, only valid during the call
+         * @param size  sizeof(Data)
+         */
+        virtual void receive( const uint32_t typeId, const void* const data, const size_t size ) = 0;
+
+        /** Get metadata of the message being received
+         * @remark Only valid from within receive()
+         * @return MessageInfo of the publish, zeroed when the publish carried none @see HasMessageInfo
+         */
+        const MessageInfo& messageInfo() const
+        { return *threadMessageInfo(); }
+
+        /** @return True if any wildcard subscriber is registered
+         */
+        static bool any()
+        { return head() != nullptr; }
+
+        /** Send Data bytes to all wildcard subscribers
+         * @see Broker<Data>::publish
+         */
+        static void deliver( const uint32_t typeId, const void* const data, const size_t size, const MessageInfo& info )
+        {
+            const MessageInfo* previousInfo = &info;
+            std::swap( threadMessageInfo(), previousInfo );
+            for ( SubscribeAny* subscriber = head(); subscriber != nullptr; )
+            {
+                SubscribeAny* const next = subscriber->next_; //< Allow unsubscribe from receive()
+                subscriber->receive( typeId, data, size );
+                subscriber = next;
+            }
+            std::swap( threadMessageInfo(), previousInfo ); //< Restore for recursive calls
+        }
+
+    private:
+        /** @return First of the intrusive list of wildcard subscribers
+         */
+        static SubscribeAny*& head()
+        {
+            static SubscribeAny* head = nullptr;
+            return head;
+        }
+
+        static const MessageInfo*& threadMessageInfo()
+        {
+            static const MessageInfo cNone = {};
+            static thread_local const MessageInfo* info = &cNone;
+            return info;
+        }
+
+        SubscribeAny* next_; ///< Next subscriber in the list from head()
+    };
+
+    /** Snapshot of the connections and metrics of a Broker<Data> @see Topology
+     */
+    struct BrokerInfo
+    {
+        static const uint32_t cMaxEndpoints = 8U; ///< Capacity of subscribers and publishers
+
+        uint32_t typeId; ///< Broker<Data>::typeId(), 0 unless SUB0PUB_TYPEIDNAME
+        const char* typeName; ///< Broker<Data>::typeName() when named, otherwise the compiler-generated name
+        size_t dataBytes; ///< sizeof(Data)
+        uint32_t subscriberCount; ///< Count of Subscribe<Data>
+        uint32_t publisherCount; ///< Count of Publish<Data>, may exceed listedPublisherCount
+        uint32_t listedPublisherCount; ///< Count of publishers
+        const void* subscribers[cMaxEndpoints]; ///< Object of each Subscribe<Data>, most-derived where RTTI is enabled
+        const void* publishers[cMaxEndpoints]; ///< Object of the first publishers registered, as subscribers
+        uint32_t publishCount; ///< MessageInfo::sequence of the latest publish, 0 without MessageInfo @see HasMessageInfo
+#if SUB0PUB_PROFILE
+        uint64_t receiveCount; ///< Sum of ReceiveProfile::count of all subscribers
+        uint64_t receiveNanoseconds; ///< Sum of ReceiveProfile::totalNanoseconds of all subscribers
+#endif
+    };
+
+    /** Process-wide list of every Broker<Data> that has had a publisher or subscriber
+     * @remark Each Broker<Data> is added on construction of its first Publish<Data> or Subscribe<Data>, the publish
+     *  path is unchanged. Export the graph with TopologyWriter @see topology.hpp
+     * @note Brokers may be listed concurrently from any thread, the list is only ever prepended
+     */
+    class Topology
+    {
+    public:
+        /** @return Count of listed brokers
+         */
+        static uint32_t size()
+        { return state().count.load( std::memory_order_relaxed ); }
+
+        /** Call 'visitor(const BrokerInfo&)' for each listed Broker<Data>, most recently listed first
+         */
+        template< typename Visitor >
+        static void visit( Visitor&& visitor )
+        {
+            for ( const Node* node = state().head.load( std::memory_order_acquire ); node != nullptr; node = node->next )
+            {
+                BrokerInfo info = {};
+                node->describe.load( std::memory_order_relaxed )( info );
+                visitor( static_cast<const BrokerInfo&>( info ) );
+            }
+        }
+
+    private:
+        template< typename Data >
+        friend class Broker;
+
+        /** Entry of the intrusive list, owned by the Broker<Data> state
+         */
+        struct Node
+        {
+            std::atomic<void (*)( BrokerInfo& info )> describe; ///< Broker<Data>::describe, nullptr until claimed for listing
+            Node* next;
+        };
+
+        struct State
+        {
+            std::atomic<Node*> head; ///< Most recently listed
+            std::atomic<uint32_t> count;
+        };
+
+        /** Claim 'node' for listing
+         * @return False if already claimed e.g. By a concurrent first use of the Broker<Data> on another thread
+         */
+        static bool claim( Node& node, void (*describe)( BrokerInfo& info ) )
+        {
+            void (*unclaimed)( BrokerInfo& info ) = nullptr;
+            return node.describe.compare_exchange_strong( unclaimed, describe, std::memory_order_relaxed );
+        }
+
+        /** Prepend a claimed 'node', published with release to visit()
+         */
+        static void add( Node& node )
+        {
+            State& topology = state();
+            node.next = topology.head.load( std::memory_order_relaxed );
+            while ( !topology.head.compare_exchange_weak( node.next, &node, std::memory_order_release, std::memory_order_relaxed ) )
+            {}
+            topology.count.fetch_add( 1U, std::memory_order_relaxed );
+        }
+
+        static State& state()
+        {
+            static State topology = {}; //< Constant initialised
+            return topology;
+        }
+    };
+
+#if SUB0PUB_TYPEIDNAME
+    class SubscribeBytes;
+
+    namespace detail
+    {
+        /** Type-erased connection of SubscribeBytes to a Broker<Data>
+        */
+        class IBytesConnection
+        {
+        public:
+            virtual ~IBytesConnection() {}
+            virtual const MessageInfo& messageInfo() const = 0;
+        };
+    } // END: detail
+
+    /** Type-erased handle to the Broker<Data> registered for a typeId
+     * @remark Allows publish and subscribe of Data known only by typeId at runtime e.g. Bridges and scripting
+     * @see TopicRegistry
+     */
+    class Topic
+    {
+    public:
+        Topic() = default;
+
+        /** Handle to Broker<Data>
+         */
+        template< typename Data >
+        static Topic make();
+
+        /** @return Unique identifier of the Data @see Broker<Data>::typeId()
+         */
+        uint32_t typeId() const
+        { return typeId_; }
+
+        /** @return Null-terminated name of the Data, nullptr if not named @see Broker<Data>::typeName()
+         */
+        const char* typeName() const
+        { return typeName_(); }
+
+        /** @return sizeof(Data)
+         */
+        size_t dataBytes() const
+        { return dataBytes_; }
+
+        /** Publish Data from bytes to subscribers of Broker<Data>
+         * @param data  Bytes of a Data, need not be aligned
+         * @param size  Count of bytes at 'data'
+         * @return False if 'size' does not match dataBytes(), nothing is published
+         */
+        bool publish( const void* const data, const size_t size ) const
+        {
+            if ( size != dataBytes_ )
+                return false;
+            publish_( data, nullptr );
+            return true;
+        }
+
+        /** Publish Data from bytes with metadata of an original publish
+         * @see Publish<Data>::publish(const Data&, const MessageInfo&)
+         */
+        bool publish( const void* const data, const size_t size, const MessageInfo& info ) const
+        {
+            if ( size != dataBytes_ )
+                return false;
+            publish_( data, &info );
+            return true;
+        }
+
+        /** @see Broker<Data>::setBudget
+         */
+        void setBudget( const LatencyBudget& budget ) const
+        { setBudget_( budget ); }
+
+#if SUB0PUB_PROFILE
+        /** @see Broker<Data>::slowestSubscribers
+         */
+        size_t slowestSubscribers( SubscriberProfile* const profiles, const size_t count ) const
+        { return slowestSubscribers_( profiles, count ); }
+#endif
+
+    private:
+        friend class SubscribeBytes;
+        friend class TopicRegistry;
+
+        uint32_t typeId_; ///< Broker<Data>::typeId(), 0 for an empty slot of TopicRegistry
+        uint32_t dataBytes_; ///< sizeof(Data)
+        const char* (*typeName_)(); ///< Broker<Data>::typeName
+        void (*publish_)( const void* data, const MessageInfo* info ); ///< Distinct per Data, identifies the Broker<Data>
+        detail::IBytesConnection* (*connect_)( SubscribeBytes& subscriber ); ///< Create Subscribe<Data> forwarding to 'subscriber'
+        void (*setBudget_)( const LatencyBudget& budget );
+#if SUB0PUB_PROFILE
+        size_t (*slowestSubscribers_)( SubscriberProfile* profiles, size_t count );
+#endif
+    };
+
+    /** Process-wide table of Topic by typeId
+     * @remark Each Broker<Data> of trivially copyable Data is added when first given a non-zero typeId. Lookup is a multiplicative hash into an
+     *  open-addressing table with linear probing, so find() is O(1) without a compile-time list of types.
+     * @note Not thread-safe against registration of new types i.e. Register types before lookup from other threads
+     * @todo State should be shared across module boundaries as for Broker<Data>
+     */
+    class TopicRegistry
+    {
+    public:
+        static const uint32_t cCapacityBits = 8U;
+        static const uint32_t cCapacity = 1U << cCapacityBits; ///< Topic limit in fixed table
+
+    public:
+        /** Get the Topic for a typeId
+         * @return Registered Topic, nullptr if no Broker has the typeId
+         */
+        static const Topic* find( const uint32_t typeId )
+        {
+            const Topic* const topics = state().topics;
+            for ( uint32_t iSlot = slot( typeId ); topics[iSlot].typeId() != 0U; iSlot = (iSlot + 1U) & (cCapacity - 1U) )
+            {
+                if ( topics[iSlot].typeId() == typeId )
+                    return &topics[iSlot];
+            }
+            return nullptr;
+        }
+
+        /** Add a Topic, ignored if the typeId is already registered for the same Data
+         * @remark Fails if the typeId is registered for a different Data type, even of the same size
+         */
+        static void add( const Topic& topic )
+        {
+            const char* failureMessage = nullptr;
+            State& registry = state();
+            uint32_t iSlot = slot( topic.typeId() );
+            while ( registry.topics[iSlot].typeId() != 0U && registry.topics[iSlot].typeId() != topic.typeId() )
+                iSlot = (iSlot + 1U) & (cCapacity - 1U);
+
+            if ( registry.topics[iSlot].typeId() == topic.typeId() )
+            {
+                if ( registry.topics[iSlot].publish_ != topic.publish_ )
+                    failureMessage = "TopicRegistry typeId registered for different Data types";
+            }
+            else if ( registry.count + 1U == cCapacity ) //< Keep one empty slot to terminate probing
+                failureMessage = "TopicRegistry capacity exceeded";
+            else
+            {
+                registry.topics[iSlot] = topic;
+                ++registry.count;
+            }
+
+            if ( failureMessage != nullptr )
+            {
+#if __cpp_exceptions
+                throw std::runtime_error(failureMessage);
+#elif SUB0PUB_ASSERT
+                assert((void*)0 == failureMessage);
+#endif
+            }
+        }
+
+        /** @return Count of registered topics
+         */
+        static uint32_t size()
+        { return state().count; }
+
+        /** Call 'visitor(const Topic&)' for each registered Topic in unspecified order
          */
-        friend OStream& operator<< ( OStream& stream, const Subscribe<Data>& subscriber )
-        { return stream << subscriber.typeName() << '{' << (void*)&subscriber << '}'; }
-#endif
+        template< typename Visitor >
+        static void visit( Visitor&& visitor )
+        {
+            for ( const Topic& topic : state().topics )
+            {
+                if ( topic.typeId() != 0U )
+                    visitor( topic );
+            }
+        }
 
     private:
-        Broker<Data> broker_; ///< MonoState broker instance to manage publish-subscribe connections
-    };
+        struct State
+        {
+            Topic topics[cCapacity]; ///< Open-addressing table, empty slots have typeId 0
+            uint32_t count; ///< Count of occupied slots
+        };
 
+        static State& state()
+        {
+            static State registry = {}; //< Constant initialised
+            return registry;
+        }
 
-    /**  Subscribe to many
-    * @todo Specialisation on std::tuple exists and could cause unexpected expansion if this was a desired type being published!
-    */
-    template< typename... Datas >
-    class SubscribeAll : public Subscribe<Datas>... 
-    {
-    public:
-        static constexpr size_t Count = sizeof...(Datas);
+        /** @return Home slot of a typeId by Fibonacci hashing
+         */
+        static uint32_t slot( const uint32_t typeId )
+        { return static_cast<uint32_t>( typeId * 2654435769U ) >> (32U - cCapacityBits); }
     };
 
-    /**  Subscribe to many defined by std::tuple type list
-    */
-    template<typename... Datas>
-    class SubscribeAll<std::tuple<Datas...>> : public Subscribe<Datas>...
+    /** Base type for an object that subscribes to Data known only by typeId, received as bytes
+     * @remark Connects to the Topic registered in TopicRegistry as a Subscribe<Data> of the Broker
+     */
+    class SubscribeBytes
     {
     public:
-        static constexpr size_t Count = sizeof...(Datas);
-    };
+        /** Subscribe to the Broker registered for typeId
+         * @note Fails if the typeId is not yet registered @see TopicRegistry::find
+         */
+        explicit SubscribeBytes( const uint32_t typeId )
+            : connection_( nullptr )
+        {
+            const Topic* const topic = TopicRegistry::find( typeId );
+            if ( topic != nullptr )
+                connection_ = topic->connect_( *this );
+            else
+            {
+                const char* failureMessage = "SubscribeBytes typeId not registered";
+#if __cpp_exceptions
+                throw std::runtime_error(failureMessage);
+#elif SUB0PUB_ASSERT
+                assert((void*)0 == failureMessage);
+#endif
+            }
+        }
 
-    /** Subscribe to many defined by multiple std::tuple type i.e. SubscribeAll< std::tuple<A,B>, std::tuple<B,C> >
-    */
-    template<typename... Datas, typename... OtherTuples>
-    class SubscribeAll<std::tuple<Datas...>, OtherTuples...> 
-        : public SubscribeAll< decltype(std::tuple_cat( std::declval<std::tuple<Datas...>>(), std::declval<OtherTuples>()...)) >
-    {};
+        virtual ~SubscribeBytes()
+        { delete connection_; }
+
+        SubscribeBytes( const SubscribeBytes& ) = delete;
+        SubscribeBytes& operator=( const SubscribeBytes& ) = delete;
+
+        /** Receive published Data
+         * @param data  Published Data, only valid during the call
+         * @param size  Topic::dataBytes()
+         */
+        virtual void receive( const void* const data, const size_t size ) = 0;
+
+        /** @return True if subscribed to a Broker
+         */
+        bool isConnected() const
+        { return connection_ != nullptr; }
+
+        /** Get metadata of the message being received
+         * @remark Only valid from within receive()
+         */
+        const MessageInfo& messageInfo() const
+        { return connection_->messageInfo(); }
+
+    private:
+        detail::IBytesConnection* connection_; ///< Owned Subscribe<Data>
+    };
+#endif
 
         
     /** Base type for an object that publishes to some strong-typed Data
@@ -500,6 +2031,33 @@ namespace sub0
         {
             detail::Check::onPublish( *this, data );
             broker_.publish(data); //< @todo Add 'this' as traceability to data source for broker specialisation etc
+            detail::Check::onPublished( *this, data );
+        }
+
+        /** Publish data to subscribers with metadata of an original publish
+         * @remark Forwards MessageInfo of a message relayed between brokers e.g. De-serialised from a stream
+         * @param[in]  data  Data value to publish to subscribers
+         * @param[in]  info  Metadata received by subscribers via Subscribe<Data>::messageInfo()
+         */
+        void publish( const Data& data, const MessageInfo& info ) const
+        {
+            detail::Check::onPublish( *this, data );
+            broker_.publish(data, info);
+            detail::Check::onPublished( *this, data );
+        }
+
+        /** Publish a batch of data to subscribers
+         * @remark Data will be received by Subscribe<Data>::receiveBatch, with a single broker hop for the batch
+         * @param[in]  data  Data values to publish in order
+         * @param[in]  count  Count of values in 'data'
+         */
+        void publish( const Data* const data, const size_t count ) const
+        {
+            if ( count == 0U )
+                return;
+            detail::Check::onPublish( *this, data[0] );
+            broker_.publish(data, count);
+            detail::Check::onPublished( *this, data[count - 1U] );
         }
         
         /** TODO: Doc
@@ -561,10 +2119,14 @@ namespace sub0
             setDataName(typeId, typeName);
 #endif
             state_.subscriptions[state_.subscriptionCount++] = subscriber;
+            listTopology();
+#if SUB0PUB_STATS
+            Stats::topic( state_.statsIndex ).subscriberCount.store( state_.subscriptionCount, std::memory_order_relaxed );
+#endif
         }
 
         /** Validated publication
-         * @remark No record of publishers of data is currently maintained
+         * @remark The first BrokerInfo::cMaxEndpoints publishers are recorded for Topology, all are counted
          * @param[in] typeName Optional unique data name given to data for inter-process signalling. 
          * @warning If typeName not supplied compiler generated names 'may' be used which are non-portable between vendors.
          */
@@ -578,91 +2140,499 @@ namespace sub0
 #if SUB0PUB_TYPEIDNAME
             setDataName(typeId, typeName);
 #endif
-            // Do nothing for now...
+            Publish<Data>** const iFree = std::find( state_.publications, state_.publications + BrokerInfo::cMaxEndpoints, nullptr );
+            if ( iFree != state_.publications + BrokerInfo::cMaxEndpoints )
+                *iFree = publisher;
+            ++state_.publicationCount;
+            listTopology();
+        }
+
+        void unsubscribe(Subscribe<Data>* subscriber)
+        {
+            Subscribe<Data>** const iRemove = std::find(state_.subscriptions, state_.subscriptions + state_.subscriptionCount, subscriber );
+#if SUB0PUB_ASSERT
+            assert(iRemove != state_.subscriptions + state_.subscriptionCount);
+#endif           
+            --state_.subscriptionCount;
+            *iRemove = state_.subscriptions[state_.subscriptionCount]; //< Insert last into removed slot @todo This changes the 'Order' of subscriptions, may have unexpected behaviour?
+#if SUB0PUB_PROFILE
+            state_.profiles[iRemove - state_.subscriptions] = state_.profiles[state_.subscriptionCount];
+            state_.profiles[state_.subscriptionCount] = ReceiveProfile();
+#endif
+#if SUB0PUB_STATS
+            Stats::topic( state_.statsIndex ).subscriberCount.store( state_.subscriptionCount, std::memory_order_relaxed );
+#endif
+
+        }
+
+        void unsubscribe(Publish<Data>* publisher)
+        {
+            Publish<Data>** const iRemove = std::find( state_.publications, state_.publications + BrokerInfo::cMaxEndpoints, publisher );
+            if ( iRemove != state_.publications + BrokerInfo::cMaxEndpoints )
+                *iRemove = nullptr;
+            --state_.publicationCount;
+        }
+
+#if SUB0PUB_TYPEIDNAME
+        /** Set a unique identifier for the data the broker manages
+         * @remark This name is used during serialisation for inter-process communications
+         * @param[in]  typeName  Null terminated compile-time string constant
+         */
+        void setDataName(const uint32_t typeId, const char* const typeName )
+        {
+            if (typeId)
+            {
+                // Check if assigning a different name or Id is when already set
+#if SUB0PUB_ASSERT
+                assert( !state_.typeId || (state_.typeId==typeId) );// @todo use RuntimeCheck and handle if a subscriber uses a different name better
+#endif
+                const bool isRegistered = (state_.typeId != 0U);
+                state_.typeId = typeId; /// @todo sub0::utility::hash(state_.typeName); // Cache hash result @todo Make compile time
+                if constexpr ( std::is_trivially_copyable<Data>::value ) //< Only Data publishable from bytes is a Topic
+                {
+                    if ( !isRegistered )
+                        TopicRegistry::add( Topic::make<Data>() );
+                }
+            }
+
+            if (typeName)
+            {
+                // Check if assigning a different name or Id is when already set
+#if SUB0PUB_ASSERT
+                assert( !state_.typeName || (std::strcmp(state_.typeName,typeName)==0) );// @todo use RuntimeCheck and handle if a subscriber uses a different name better
+#endif
+                state_.typeName = typeName;
+            }
+#if SUB0PUB_STATS
+            if ( state_.topologyNode.describe.load( std::memory_order_relaxed ) != nullptr )
+                describeStats(); //< Named after first use
+#endif
+        }
+#endif
+        
+        /**
+         * @return  Get the broker instance on the current thread
+        */
+        const Broker* active() const
+        { return threadCurrent_; }
+
+        /** Cancel the broker publish on the current thread preventing further receive of data 
+        */
+        void cancel() const
+        {
+            //@todo Sanity check only cancel the active broker? assert(active() == this);
+            assert( active() != nullptr ); //< Critical cannot be called from outside callback context
+            active()->publishCanceled_ = true;
+        }
+
+        /** @return True if the broker publish on the current thread is cancelled
+        */
+        bool isCanceled() const
+        { return active() != nullptr && active()->publishCanceled_; }
+
+        /** Report the outcome of Subscribe<Data>::receiveBatch to the batch publish on the current thread
+         * @param received  Count of elements passing filter() and received
+         * @param end  Count of elements before a cancel(), later subscribers receive only these
+         */
+        static void endBatch( const size_t received, const size_t end )
+        {
+            if ( threadBatch_ == nullptr )
+                return; //< Not called from a batch publish
+            threadBatch_->received = received;
+            threadBatch_->end = end;
+        }
+
+        /** Send data to registered subscribers
+         * @remark MessageInfo is captured when enabled for the Data type @see HasMessageInfo
+         * @param data  Data sent to subscribers via their 'receive()' function
+         */
+        void publish(const Data& data) const
+        {
+            if constexpr ( HasMessageInfo<Data>::value )
+                publish( data, MessageInfo{ utility::Clock::now(), ++state_.sequence } );
+            else
+                deliver( data );
+        }
+
+        /** Send data to registered subscribers with metadata
+         * @param data  Data sent to subscribers via their 'receive()' function
+         * @param info  Metadata available to subscribers via messageInfo() during delivery
+         */
+        void publish(const Data& data, const MessageInfo& info) const
+        {
+            MessageInfo previousInfo = info;
+            std::swap(threadMessageInfo_, previousInfo);
+            deliver( data );
+            std::swap(threadMessageInfo_, previousInfo); //< Restore for recursive calls
+        }
+
+        /** Send a batch of data to registered subscribers
+         * @remark Each subscriber receives the whole batch through 'receiveBatch()'. Where MessageInfo or history is
+         *  enabled for the Data type each element is published alone, as each has its own metadata.
+         * @param data  Data sent to subscribers in order
+         * @param count  Count of elements in 'data', not zero
+         */
+        void publish(const Data* const data, const size_t count) const
+        {
+            if constexpr ( HasMessageInfo<Data>::value || HistoryDepth<Data>::value != 0U )
+            {
+                for ( size_t iData = 0U; iData < count; ++iData )
+                    publish( data[iData] );
+            }
+            else
+                deliverBatch( data, count );
+        }
+
+        /** @return Metadata of the message being delivered on the current thread
+         */
+        static const MessageInfo& messageInfo()
+        { return threadMessageInfo_; }
+
+        /** Deliver retained publishes to a single subscriber @see Subscribe<Data>::replay
+         * @return Count of messages received
+         */
+        uint32_t replay( Subscribe<Data>* const subscriber ) const
+        {
+            if constexpr ( HistoryDepth<Data>::value == 0U )
+                return 0U;
+            else
+            {
+                const Broker* previousPublisher = this;
+                std::swap(threadCurrent_, previousPublisher);
+
+                uint32_t received = 0U;
+                const uint64_t end = state_.history.recorded(); //< Messages published by receive() are delivered live instead
+                for ( uint64_t position = end - state_.history.size(); !publishCanceled_ && position < end; ++position )
+                {
+                    const detail::HistoryEntry<Data>* const retained = state_.history.find( position );
+                    if ( retained == nullptr )
+                        continue; //< Overwritten by a publish from receive() while full, which shifts the ring
+                    const detail::HistoryEntry<Data> entry = *retained; //< Copy as a publish from receive() overwrites the oldest
+                    MessageInfo previousInfo = {};
+                    if constexpr ( HasMessageInfo<Data>::value )
+                        previousInfo = entry.info;
+                    std::swap(threadMessageInfo_, previousInfo);
+                    if ( subscriber->filter(entry.data) )
+                    {
+                        subscriber->receive(entry.data);
+                        ++received;
+                    }
+                    std::swap(threadMessageInfo_, previousInfo);
+                }
+
+                publishCanceled_ = false;
+                std::swap(threadCurrent_, previousPublisher);
+                return received;
+            }
+        }
+
+        /** Discard retained publishes e.g. Where they no longer describe the current state
+         */
+        static void clearHistory()
+        { state_.history.clear(); }
+
+        /** Set the time budget of each receive() of the Data
+         * @remark Subscribers exceeding the budget are reported to LatencyBudget::callback without allocation
+         * @note Not thread-safe against concurrent publish of the Data
+         */
+        static void setBudget( const LatencyBudget& budget )
+        {
+            state_.budget = budget;
+            state_.budgetReported = false;
+            state_.budgetSuppressed = 0U;
+        }
+
+        /** @return Time budget of each receive() of the Data
+         */
+        static const LatencyBudget& budget()
+        { return state_.budget; }
+
+#if SUB0PUB_PROFILE
+        /** Get the subscribers with the largest total receive() time
+         * @param[out] profiles  Filled with up to 'count' profiles, slowest first
+         * @param count  Capacity of 'profiles'
+         * @return Count of profiles filled
+         */
+        static size_t slowestSubscribers( SubscriberProfile* const profiles, const size_t count )
+        {
+            SubscriberProfile ranked[cMaxSubscriptions];
+            for ( uint32_t iSubscription = 0U; iSubscription < state_.subscriptionCount; ++iSubscription )
+                ranked[iSubscription] = SubscriberProfile{ state_.subscriptions[iSubscription], state_.profiles[iSubscription] };
+
+            const size_t rankedCount = std::min<size_t>( count, state_.subscriptionCount );
+            std::partial_sort( ranked, ranked + rankedCount, ranked + state_.subscriptionCount
+                , []( const SubscriberProfile& lhs, const SubscriberProfile& rhs ) { return lhs.profile.totalNanoseconds > rhs.profile.totalNanoseconds; } );
+            std::copy( ranked, ranked + rankedCount, profiles );
+            return rankedCount;
+        }
+
+        /** Clear ReceiveProfile of all subscribers
+         */
+        static void resetProfiles()
+        { std::fill( state_.profiles, state_.profiles + cMaxSubscriptions, ReceiveProfile() ); }
+#endif
+
+    private:
+        /** Deliver data to registered subscribers
+         * @param data  Data sent to subscribers via their 'receive()' function
+         */
+        void deliver(const Data& data) const
+        {
+            assert(publishCanceled_ == false);
+
+#if SUB0PUB_TYPEIDNAME
+            const uint32_t typeId = state_.typeId;
+#else
+            const uint32_t typeId = 0U;
+#endif
+            SUB0_PROBE( publish_begin, typeId, &data, sizeof(Data) );
+#if SUB0PUB_CAUSALITY
+            const Causality::Span span = Causality::enter();
+#endif
+#if SUB0PUB_STATS
+            const uint64_t statsBegin = utility::Clock::now();
+            uint32_t deliveries = 0U;
+#endif
+
+            if ( SubscribeAny::any() )
+                SubscribeAny::deliver( typeId, &data, sizeof(Data), threadMessageInfo_ );
+
+            const Broker* previousPublisher = this;
+            std::swap(threadCurrent_, previousPublisher);
+
+            for (uint32_t iSubscription = 0U; !publishCanceled_ && iSubscription < state_.subscriptionCount; ++iSubscription )
+            {
+                Subscribe<Data>* subscription = state_.subscriptions[iSubscription];
+                detail::Check::onReceive( subscription, data );
+
+                if ( subscription->filter(data))
+                {
+                    SUB0_PROBE( receive_begin, typeId, &data, sizeof(Data) );
+#if SUB0PUB_STATS
+                    ++deliveries;
+#endif
+                    if ( !SUB0PUB_PROFILE && state_.budget.nanoseconds == 0U )
+                        subscription->receive(data);
+                    else
+                    {
+                        const uint64_t start = utility::Clock::now();
+                        subscription->receive(data);
+                        const uint64_t elapsed = utility::Clock::now() - start;
+#if SUB0PUB_PROFILE
+                        state_.profiles[iSubscription].record( elapsed );
+#endif
+                        if ( state_.budget.nanoseconds != 0U && elapsed > state_.budget.nanoseconds )
+                            overrun( subscription, start + elapsed, elapsed );
+                    }
+                    SUB0_PROBE( receive_end, typeId, &data, sizeof(Data) );
+                }
+                detail::Check::onReceived( subscription, data );
+            }
+
+            publishCanceled_ = false;
+            state_.history.record( data, threadMessageInfo_ ); //< After delivery so subscribers added by receive() replay it once
+#if SUB0PUB_STATS
+            const uint32_t drops = (state_.subscriptionCount > deliveries) ? state_.subscriptionCount - deliveries : 0U;
+            Stats::record( state_.statsIndex, 1U, deliveries, drops, utility::Clock::now() - statsBegin );
+#endif
+            std::swap(threadCurrent_, previousPublisher); //< Restore for recursive calls
+            assert(previousPublisher == this);
+#if SUB0PUB_CAUSALITY && SUB0PUB_TYPEIDNAME
+            Causality::leave( span, typeId, state_.typeName );
+#elif SUB0PUB_CAUSALITY
+            Causality::leave( span, typeId, nullptr );
+#endif
+            SUB0_PROBE( publish_end, typeId, &data, sizeof(Data) );
+        }
+
+        /** Deliver a batch of data to registered subscribers
+         * @remark As deliver() with one receiveBatch() per subscriber. SubscribeAny receives each element. A cancel()
+         *  at an element ends the batch there, later subscribers receive only the elements before it while earlier
+         *  subscribers have received the whole batch. The budget applies per element, the whole batch may take
+         *  'count' times LatencyBudget::nanoseconds.
+         * @param data  Data sent to subscribers via their 'receiveBatch()' function
+         * @param count  Count of elements in 'data', not zero
+         */
+        void deliverBatch(const Data* const data, const size_t count) const
+        {
+            assert(publishCanceled_ == false);
+            assert(count != 0U);
+
+#if SUB0PUB_TYPEIDNAME
+            const uint32_t typeId = state_.typeId;
+#else
+            const uint32_t typeId = 0U;
+#endif
+            SUB0_PROBE( publish_begin, typeId, data, count * sizeof(Data) );
+#if SUB0PUB_CAUSALITY
+            const Causality::Span span = Causality::enter();
+#endif
+#if SUB0PUB_STATS
+            const uint64_t statsBegin = utility::Clock::now();
+            uint32_t deliveries = 0U;
+#endif
+
+            if ( SubscribeAny::any() )
+            {
+                for ( size_t iData = 0U; iData < count; ++iData )
+                    SubscribeAny::deliver( typeId, &data[iData], sizeof(Data), threadMessageInfo_ );
+            }
+
+            const Broker* previousPublisher = this;
+            std::swap(threadCurrent_, previousPublisher);
+            BatchOutcome batch = {};
+            BatchOutcome* previousBatch = &batch;
+            std::swap(threadBatch_, previousBatch);
+
+            size_t end = count; //< Elements delivered to the next subscriber, reduced by cancel()
+            for (uint32_t iSubscription = 0U; end != 0U && iSubscription < state_.subscriptionCount; ++iSubscription )
+            {
+                Subscribe<Data>* subscription = state_.subscriptions[iSubscription];
+                detail::Check::onReceive( subscription, data[0] );
+                SUB0_PROBE( receive_begin, typeId, data, end * sizeof(Data) );
+                batch = BatchOutcome{ end, 0U }; //< Unless reported by endBatch(), all are received and cancel() ends the batch
+                if ( !SUB0PUB_PROFILE && state_.budget.nanoseconds == 0U )
+                    subscription->receiveBatch(data, end);
+                else
+                {
+                    const uint64_t start = utility::Clock::now();
+                    subscription->receiveBatch(data, end);
+                    const uint64_t elapsed = utility::Clock::now() - start;
+#if SUB0PUB_PROFILE
+                    state_.profiles[iSubscription].record( elapsed );
+#endif
+                    if ( state_.budget.nanoseconds != 0U && elapsed > state_.budget.nanoseconds * end )
+                    {
+                        if ( !publishCanceled_ )
+                            batch.end = 0U; //< Cancel on overrun ends the whole batch
+                        overrun( subscription, start + elapsed, elapsed );
+                    }
+                }
+                SUB0_PROBE( receive_end, typeId, data, end * sizeof(Data) );
+                detail::Check::onReceived( subscription, data[end - 1U] );
+#if SUB0PUB_STATS
+                deliveries += static_cast<uint32_t>( batch.received );
+#endif
+                if ( publishCanceled_ )
+                {
+                    end = batch.end;
+                    publishCanceled_ = false;
+                }
+            }
+
+            publishCanceled_ = false;
+            std::swap(threadBatch_, previousBatch);
+#if SUB0PUB_STATS
+            const uint32_t offered = state_.subscriptionCount * static_cast<uint32_t>( count );
+            Stats::record( state_.statsIndex, static_cast<uint32_t>( count ), deliveries, (offered > deliveries) ? offered - deliveries : 0U, utility::Clock::now() - statsBegin );
+#endif
+            std::swap(threadCurrent_, previousPublisher); //< Restore for recursive calls
+            assert(previousPublisher == this);
+#if SUB0PUB_CAUSALITY && SUB0PUB_TYPEIDNAME
+            Causality::leave( span, typeId, state_.typeName );
+#elif SUB0PUB_CAUSALITY
+            Causality::leave( span, typeId, nullptr );
+#endif
+            SUB0_PROBE( publish_end, typeId, data, count * sizeof(Data) );
         }
 
-        void unsubscribe(Subscribe<Data>* subscriber)
+        /** Add to Topology on first use
+         */
+        static void listTopology()
         {
-            Subscribe<Data>** const iRemove = std::find(state_.subscriptions, state_.subscriptions + state_.subscriptionCount, subscriber );
-#if SUB0PUB_ASSERT
-            assert(iRemove != state_.subscriptions + state_.subscriptionCount);
-#endif           
-            --state_.subscriptionCount;
-            *iRemove = state_.subscriptions[state_.subscriptionCount]; //< Insert last into removed slot @todo This changes the 'Order' of subscriptions, may have unexpected behaviour?
-
+            if ( state_.topologyNode.describe.load( std::memory_order_relaxed ) != nullptr
+              || !Topology::claim( state_.topologyNode, &describe ) )
+                return;
+            Topology::add( state_.topologyNode );
+#if SUB0PUB_STATS
+            state_.statsIndex = Stats::reserve();
+            describeStats();
+            Stats::list( state_.statsIndex );
+#endif
         }
 
-        void unsubscribe(Publish<Data>* publisher)
+#if SUB0PUB_STATS
+        /** Set the type description of the StatsTopic
+         */
+        static void describeStats()
         {
-            // Do nothing for now...
+#if SUB0PUB_TYPEIDNAME
+            Stats::describe( state_.statsIndex, state_.typeId
+                , (state_.typeName != nullptr) ? state_.typeName : detail::compilerTypeName<Data>(), sizeof(Data) );
+#else
+            Stats::describe( state_.statsIndex, 0U, detail::compilerTypeName<Data>(), sizeof(Data) );
+#endif
         }
+#endif
 
-#if SUB0PUB_TYPEIDNAME
-        /** Set a unique identifier for the data the broker manages
-         * @remark This name is used during serialisation for inter-process communications
-         * @param[in]  typeName  Null terminated compile-time string constant
+        /** Fill BrokerInfo from the current state @see Topology::visit
          */
-        void setDataName(const uint32_t typeId, const char* const typeName )
+        static void describe( BrokerInfo& info )
         {
-            if (typeId)
-            {
-                // Check if assigning a different name or Id is when already set
-#if SUB0PUB_ASSERT
-                assert( !state_.typeId || (state_.typeId==typeId) );// @todo use RuntimeCheck and handle if a subscriber uses a different name better
+            static_assert( cMaxSubscriptions <= BrokerInfo::cMaxEndpoints, "BrokerInfo must list every subscription" );
+#if SUB0PUB_TYPEIDNAME
+            info.typeId = state_.typeId;
+            info.typeName = (state_.typeName != nullptr) ? state_.typeName : detail::compilerTypeName<Data>();
+#else
+            info.typeId = 0U;
+            info.typeName = detail::compilerTypeName<Data>();
 #endif
-                state_.typeId = typeId; /// @todo sub0::utility::hash(state_.typeName); // Cache hash result @todo Make compile time
+            info.dataBytes = sizeof(Data);
+            info.subscriberCount = state_.subscriptionCount;
+            info.publisherCount = state_.publicationCount;
+            info.listedPublisherCount = 0U;
+            info.publishCount = state_.sequence;
+            for ( uint32_t iSubscription = 0U; iSubscription < state_.subscriptionCount; ++iSubscription )
+                info.subscribers[iSubscription] = detail::mostDerived( state_.subscriptions[iSubscription] );
+            for ( const Publish<Data>* publisher : state_.publications )
+            {
+                if ( publisher != nullptr )
+                    info.publishers[info.listedPublisherCount++] = detail::mostDerived( publisher );
             }
-
-            if (typeName)
+#if SUB0PUB_PROFILE
+            info.receiveCount = 0U;
+            info.receiveNanoseconds = 0U;
+            for ( uint32_t iSubscription = 0U; iSubscription < state_.subscriptionCount; ++iSubscription )
             {
-                // Check if assigning a different name or Id is when already set
-#if SUB0PUB_ASSERT
-                assert( !state_.typeName || (std::strcmp(state_.typeName,typeName)==0) );// @todo use RuntimeCheck and handle if a subscriber uses a different name better
-#endif
-                state_.typeName = typeName;
+                info.receiveCount += state_.profiles[iSubscription].count;
+                info.receiveNanoseconds += state_.profiles[iSubscription].totalNanoseconds;
             }
-        }
 #endif
-        
-        /**
-         * @return  Get the broker instance on the current thread
-        */
-        const Broker* active() const
-        { return threadCurrent_; }
-
-        /** Cancel the broker publish on the current thread preventing further receive of data 
-        */
-        void cancel() const
-        {
-            //@todo Sanity check only cancel the active broker? assert(active() == this);
-            assert( active() != nullptr ); //< Critical cannot be called from outside callback context
-            active()->publishCanceled_ = true;
         }
 
-        /** Send data to registered subscribers
-         * @param data  Data sent to subscribers via their 'receive()' function
+        /** Report a receive() exceeding the LatencyBudget, rate limited by LatencyBudget::minReportNanoseconds
+         * @param subscriber  Subscriber whose receive() overran
+         * @param now  utility::Clock time the receive() returned
+         * @param elapsed  Duration of the receive()
          */
-        void publish(const Data& data) const
+        void overrun( const Subscribe<Data>* const subscriber, const uint64_t now, const uint64_t elapsed ) const
         {
-            assert(publishCanceled_ == false);
-
-            const Broker* previousPublisher = this;
-            std::swap(threadCurrent_, previousPublisher);
+            const LatencyBudget& budget = state_.budget;
+            if ( budget.cancelOnOverrun )
+                publishCanceled_ = true;
 
-            for (uint32_t iSubscription = 0U; !publishCanceled_ && iSubscription < state_.subscriptionCount; ++iSubscription )
+            if ( state_.budgetReported && (now - state_.budgetReportTime < budget.minReportNanoseconds) )
             {
-                Subscribe<Data>* subscription = state_.subscriptions[iSubscription];
-                detail::Check::onReceive( subscription, data );
-
-                if ( subscription->filter(data))
-                    subscription->receive(data);
+                ++state_.budgetSuppressed;
+                return;
             }
 
-            publishCanceled_ = false;
-            std::swap(threadCurrent_, previousPublisher); //< Restore for recursive calls
-            assert(previousPublisher == this);
+            const BudgetOverrun report = {
+#if SUB0PUB_TYPEIDNAME
+                state_.typeId, state_.typeName
+#else
+                0U, nullptr
+#endif
+                , subscriber, elapsed, budget.nanoseconds, state_.budgetSuppressed };
+            state_.budgetReported = true;
+            state_.budgetReportTime = now;
+            state_.budgetSuppressed = 0U;
+            if ( budget.callback != nullptr )
+                budget.callback( report, budget.context );
         }
 
+    public:
+
         /** Prints address of monotonic state
          * @param stream  Stream to output into
          * @param broker  Broker instance to output for
@@ -699,18 +2669,45 @@ namespace sub0
 
             uint32_t subscriptionCount = 0; ///< Count of subscriptions_
             Subscribe<Data>* subscriptions[cMaxSubscriptions] = {};    ///< Subscription table @todo More flexible count-support
+            uint32_t sequence = 0; ///< Count of publishes for MessageInfo::sequence @see HasMessageInfo
+            uint32_t publicationCount = 0; ///< Count of Publish<Data>
+            Publish<Data>* publications[BrokerInfo::cMaxEndpoints] = {}; ///< First publishers, nullptr for a free slot
+            Topology::Node topologyNode = {}; ///< Entry in Topology, listed on first use
+            detail::History<Data> history; ///< Latest publishes, empty unless SUB0_HISTORY @see HistoryDepth
+#if SUB0PUB_STATS
+            uint32_t statsIndex = 0U; ///< Slot of the topic in Stats::layout(), assigned on first use
+#endif
+#if SUB0PUB_PROFILE
+            ReceiveProfile profiles[cMaxSubscriptions] = {}; ///< Receive timing of subscriptions[] at the same index
+#endif
+            LatencyBudget budget; ///< Budget of each receive(), disabled when budget.nanoseconds is 0
+            bool budgetReported = false; ///< True once an overrun is reported
+            uint64_t budgetReportTime = 0U; ///< utility::Clock time of the last overrun report
+            uint32_t budgetSuppressed = 0U; ///< Overruns not reported since budgetReportTime
 #if SUB0PUB_TYPEIDNAME
             uint32_t typeId; ///< Type identifier index or name hash
             const char* typeName; ///< user defined data name overrides non-portable compiler-generated name
 #endif
         };
 
+        /** Result of one subscriber's receiveBatch() @see endBatch
+         */
+        struct BatchOutcome
+        {
+            size_t received; ///< Elements received
+            size_t end; ///< Elements before a cancel()
+        };
+
 #ifdef __cpp_inline_variables
         inline static State state_ = {}; ///< MonoState subscription table
         inline static thread_local const Broker* threadCurrent_ = nullptr; //< Active publisher
+        inline static thread_local MessageInfo threadMessageInfo_ = {}; //< Metadata of message being delivered
+        inline static thread_local BatchOutcome* threadBatch_ = nullptr; //< Outcome of receiveBatch() in the active batch publish
 #else
         static State state_; ///< MonoState subscription table
         static thread_local const Broker* threadCurrent_ = nullptr; //< Active publisher
+        static thread_local MessageInfo threadMessageInfo_; //< Metadata of message being delivered
+        static thread_local BatchOutcome* threadBatch_; //< Outcome of receiveBatch() in the active batch publish
 #endif
 
         mutable bool publishCanceled_ = false; //< Flag indicating this instance of publish is cancelled
@@ -725,6 +2722,72 @@ namespace sub0
 
     template<typename Data>
     thread_local const typename Broker<Data>* Broker<Data>::threadCurrent_ = nullptr;
+
+    template<typename Data>
+    thread_local MessageInfo Broker<Data>::threadMessageInfo_ = MessageInfo();
+
+    template<typename Data>
+    thread_local typename Broker<Data>::BatchOutcome* Broker<Data>::threadBatch_ = nullptr;
+#endif
+
+#if SUB0PUB_TYPEIDNAME
+    namespace detail
+    {
+        /** Subscribe<Data> forwarding to SubscribeBytes
+        */
+        template< typename Data >
+        class BytesConnection : public Subscribe<Data>
+                              , public IBytesConnection
+        {
+        public:
+            explicit BytesConnection( SubscribeBytes& subscriber )
+                : subscriber_( subscriber )
+            {}
+
+            void receive( const Data& data ) override
+            { subscriber_.receive( &data, sizeof(Data) ); }
+
+            const MessageInfo& messageInfo() const override
+            { return Subscribe<Data>::messageInfo(); }
+
+        private:
+            SubscribeBytes& subscriber_;
+        };
+    } // END: detail
+
+    template< typename Data >
+    Topic Topic::make()
+    {
+        static_assert( std::is_trivially_copyable<Data>::value, "Topic Data must be trivially copyable to publish from bytes" );
+
+        Topic topic;
+        topic.typeId_ = Broker<Data>::typeId();
+        topic.dataBytes_ = sizeof(Data);
+        topic.typeName_ = &Broker<Data>::typeName;
+        topic.publish_ = []( const void* const data, const MessageInfo* const info )
+        {
+            static const Publish<Data> publisher;
+            const Data* aligned = static_cast<const Data*>( data );
+            alignas(Data) char copy[sizeof(Data)];
+            if ( reinterpret_cast<uintptr_t>( data ) % alignof(Data) != 0U )
+            {
+                std::memcpy( copy, data, sizeof(Data) );
+                aligned = reinterpret_cast<const Data*>( copy );
+            }
+
+            if ( info != nullptr )
+                publisher.publish( *aligned, *info );
+            else
+                publisher.publish( *aligned );
+        };
+        topic.connect_ = []( SubscribeBytes& subscriber ) -> detail::IBytesConnection*
+        { return new detail::BytesConnection<Data>( subscriber ); };
+        topic.setBudget_ = &Broker<Data>::setBudget;
+#if SUB0PUB_PROFILE
+        topic.slowestSubscribers_ = &Broker<Data>::slowestSubscribers;
+#endif
+        return topic;
+    }
 #endif
 
 #if 0 //< @todo Not necessary since c++11?
@@ -794,6 +2857,12 @@ namespace sub0
         /** Publish the data owned by the object
          */
         virtual void publish() = 0;
+
+        /** Publish the data owned by the object with metadata of the original publish e.g. Decoded from a stream
+         * @note Metadata is discarded unless overridden
+         */
+        virtual void publish( const MessageInfo& info )
+        { publish(); }
     };
 
     template< typename Prefix_t
@@ -809,8 +2878,19 @@ namespace sub0
          * @param stream  Stream to write into
          * @param data  Data to construct a header record and data payload for
          */
-        template<typename Data_t>
-        inline bool write(OStream& stream, const Data_t& data) const
+        template<typename Data_t, typename ByteSink>
+        inline bool write(ByteSink& stream, const Data_t& data) const
+        {
+            return write(stream, Header_t(data), data);
+        }
+
+        /** Output specified header and pay-load for data as binary
+         * @param stream  Stream to write into
+         * @param header  Header record for the payload
+         * @param data  Data payload
+         */
+        template<typename Data_t, typename ByteSink>
+        inline bool write(ByteSink& stream, const Header_t& header, const Data_t& data) const
         {
 #if 0
             char buffer[utility::sizeOf<Prefix_t>() + utility::sizeOf<Header_t>() + utility::sizeOf<Data_t>() + utility::sizeOf<Postfix_t>()];
@@ -821,19 +2901,21 @@ namespace sub0
             return stream.write(buffer, sizeof(buffer));
 #else
             return utility::write<Prefix_t>(stream)
-                && utility::write(stream, Header_t(data) )
+                && utility::write(stream, header )
                 && utility::write(stream, data )
                 && utility::write<Postfix_t>(stream);
 #endif
         }
 
-        bool open(OStream& stream)
+        template<typename ByteSink>
+        bool open(ByteSink& stream)
         {
             /* Do nothing */
             return true;
         }
 
-        void close( OStream& stream  )
+        template<typename ByteSink>
+        void close( ByteSink& stream  )
         {
             /* Do nothing */
         }
@@ -849,6 +2931,7 @@ namespace sub0
                                   * @note Negative pad leaves unopulated bytes in buffer which are zeroed
                                   * @note For protocol version compatibility when payloads grow
                                   */
+        uint32_t typeId; ///< Broker<Data>::typeId() of the registered buffer, 0 for stream framing and unless SUB0PUB_TYPEIDNAME
     };
 
     /** @tparam  cMaxDataBufferCount  Defines the maximum number of Data type buffers the deserializer can store
@@ -883,6 +2966,11 @@ namespace sub0
                     , reinterpret_cast<char*>(&buffer)
                     , static_cast<uint_least16_t>(sizeof(buffer))
                     , paddingSize
+#if SUB0PUB_TYPEIDNAME
+                    , Broker<Data>::typeId()
+#else
+                    , 0U
+#endif
                } );
         }
 
@@ -941,6 +3029,16 @@ namespace sub0
             return true;
         }
 
+        /** Signal completion of a buffer read for header
+         * @remark Default publishes without metadata, the header is available for protocols carrying MessageInfo
+         * @param header  Header data of the completed payload
+         * @param publisher  Publisher of the completed buffer
+        */
+        void publish(const Header_t& header, IPublish& publisher)
+        {
+            publisher.publish();
+        }
+
     private:
         HeaderToBufferLookup registry_;
         typename HeaderToBufferLookup::iterator registryEnd_; ///< Iterator to end of registry_ @note Count = registryEnd_-registry_
@@ -973,9 +3071,10 @@ namespace sub0
             , postfix_()
         {}
 
-        /** Initialise from IStream
+        /** Initialise from ByteSource
         */
-        bool open(IStream& stream)
+        template<typename ByteSource>
+        bool open(ByteSource& stream)
         {
             //TODO: Do this on open or close?
             state_ = !std::is_void<Prefix_t>::value ? State::Prefix : stateAfter(State::Prefix);
@@ -985,7 +3084,8 @@ namespace sub0
 
         /** Read from the stream
         */
-        bool update(IStream& stream)
+        template<typename ByteSource>
+        bool update(ByteSource& stream)
         {
             /// Read data until an incomplete message
             while (readBuffer(stream))
@@ -1006,7 +3106,8 @@ namespace sub0
             dataBufferRegistery_.set(dataBuffer, publisher);
         }
 
-        bool close( IStream& stream  )
+        template<typename ByteSource>
+        bool close( ByteSource& stream  )
         {
             dataBufferRegistery_.close(); ///< @TODO This is here as a use-case contained stream state wihin the buffer map! Remove/deprecate this when/as possible
             return true;
@@ -1028,22 +3129,19 @@ namespace sub0
             case State::Data:   
                 return dataBufferRegistery_.find(header_);
             case State::Postfix: 
-                return {currentBuffer_.publisher , reinterpret_cast<char*>(&postfix_), static_cast<uint_least16_t>( !std::is_void<Postfix_t>::value ? sizeof(postfix_) : 0U), 0U};
+                return {currentBuffer_.publisher , reinterpret_cast<char*>(&postfix_), static_cast<uint_least16_t>( !std::is_void<Postfix_t>::value ? sizeof(postfix_) : 0U), 0U, currentBuffer_.typeId};
             }
         }
         
         /** Read payload data from stream and detect payload completion
          * @return True when data packet(s) have been published, false if no completed packet was present in stream
         */
-        bool readBuffer(IStream& stream)
+        template<typename ByteSource>
+        bool readBuffer(ByteSource& stream)
         {
             if (currentBuffer_.bufferSize > 0)
             {
-#if SUB0PUB_STD
-                const uint_fast16_t readCount = static_cast<uint_fast16_t>(stream.read(currentBuffer_.buffer, currentBuffer_.bufferSize).gcount()); ///< @todo readsome() for async
-#else
-                const uint_fast16_t readCount = stream.read(currentBuffer_.buffer, currentBuffer_.bufferSize);
-#endif
+                const uint_fast16_t readCount = static_cast<uint_fast16_t>(utility::read(stream, currentBuffer_.buffer, currentBuffer_.bufferSize));
                 currentBuffer_.buffer += readCount;
                 currentBuffer_.bufferSize -= readCount;
 
@@ -1057,11 +3155,7 @@ namespace sub0
 #if 1 /// @todo stream.ignore() functionality does not act as expected!?
                 char ignoreBuff[256];
                 const size_t ignoreSize = std::min(std::size(ignoreBuff), static_cast<size_t>(currentBuffer_.paddingSize));
-    #if SUB0PUB_STD
-                const uint_fast16_t ignoreCount = static_cast<uint_fast16_t>(stream.read(ignoreBuff, ignoreSize ).gcount()); ///< @todo readsome() for async
-    #else
-                const uint_fast16_t ignoreCount = stream.read(ignoreBuff, ignoreSize );
-    #endif
+                const uint_fast16_t ignoreCount = static_cast<uint_fast16_t>(utility::read(stream, ignoreBuff, ignoreSize));
 #else
     #if SUB0PUB_STD
                  const uint_fast16_t ignoreCount = static_cast<uint_fast16_t>(stream.ignore(currentBuffer_.paddingSize).gcount()); ///< @todo readsome() for async
@@ -1118,6 +3212,8 @@ namespace sub0
             if(stateStatus)
                 return true;
 
+            SUB0_PROBE( sync_lost, currentBuffer_.typeId, &header_, sizeof(header_) );
+
             const char* failureMessage = nullptr;
             switch(currentState)
             {
@@ -1151,8 +3247,9 @@ namespace sub0
 #if SUB0PUB_ASSERT
                 assert(currentBuffer_.publisher);
 #endif
+                SUB0_PROBE( frame_complete, frame_.typeId, frame_.buffer, frame_.bufferSize );
                 if (currentBuffer_.publisher)
-                    currentBuffer_.publisher->publish(); // Signal completion of buffer content to publish data signal
+                    dataBufferRegistery_.publish(header_, *currentBuffer_.publisher); // Signal completion of buffer content to publish data signal
             }
 
             state_ = stateAfter( state_ );
@@ -1161,6 +3258,8 @@ namespace sub0
             // Check if header maps to a recognised Data
             if ( currentBuffer_.buffer == nullptr)/// @todo Does not handle and discard unrecognised typeId [Critical]
             {
+                SUB0_PROBE( sync_lost, 0U, &header_, sizeof(header_) ); //< Unrecognised header has no registered typeId
+
                 const char* failureMessage = nullptr;
                 if ( state_ == State::Data )
                     failureMessage = "Sub0Pub - Data buffer is null, potential payload size mismatch or unrecognised Id"; /// @todo Does not handle changed data structure size [Critical]
@@ -1183,6 +3282,10 @@ namespace sub0
                 currentBuffer_.bufferSize += currentBuffer_.paddingSize;
                 currentBuffer_.paddingSize = 0;
             }
+#if SUB0PUB_HAS_USDT
+            if ( state_ == State::Data )
+                frame_ = currentBuffer_; //< Staged bytes of the payload, not header size which differs for encoded payloads
+#endif
 
             return currentBuffer_.buffer != nullptr;
         }
@@ -1201,6 +3304,9 @@ namespace sub0
         MemberPrefix_t prefix_;
         Header_t header_; ///< Packet head buffer
         MemberPostfix_t postfix_;
+#if SUB0PUB_HAS_USDT
+        Buffer frame_ = Buffer(); ///< Payload buffer being read, frame_complete probe arguments
+#endif
     };
 
     /** Binary protocol for serialised signal and data transfer
@@ -1211,6 +3317,9 @@ namespace sub0
         struct Prefix
         {
             const uint32_t magic = sub0::utility::FourCC<'S', 'U', 'B', '0'>::value; //< Magic number to identify Sub0 network protocol packets
+
+            bool operator == (const Prefix& rhs) const
+            { return magic == rhs.magic; }
         };
 
         /** Header containing signal type information
@@ -1249,31 +3358,279 @@ namespace sub0
         struct Postfix
         {
             const uint8_t delim = '\n';
+
+            bool operator == (const Postfix& rhs) const
+            { return delim == rhs.delim; }
         };
 
         using Writer = BinaryWriter<Prefix, Header, Postfix>;
         using Reader = BinaryReader<Prefix, Header, Postfix>;
     };
 
+    /** Writes binary frames with MessageInfo of each message encoded into the header
+     * @remark Header_t::timestampDelta is nanoseconds since the previous timestamp in the stream. A clock frame of
+     *  Header_t::cClockTypeId carrying the absolute timestamp is written before the first timestamp and whenever the
+     *  delta is negative or exceeds 32-bits.
+     * @see MessageInfoSerialisation
+     */
+    template< typename Prefix_t
+            , typename Header_t
+            , typename Postfix_t >
+    class MessageInfoWriter : public BinaryWriter<Prefix_t, Header_t, Postfix_t>
+    {
+    public:
+        MessageInfoWriter()
+            : BinaryWriter<Prefix_t, Header_t, Postfix_t>()
+            , previous_(0U)
+            , synced_(false)
+        {}
+
+        /** Output header with MessageInfo of the message being delivered and pay-load for data as binary
+         * @param stream  Stream to write into
+         * @param data  Data to construct a header record and data payload for
+         */
+        template<typename Data_t, typename ByteSink>
+        inline bool write(ByteSink& stream, const Data_t& data)
+        {
+            Header_t header(data);
+
+            const MessageInfo& info = Broker<Data_t>::messageInfo();
+            if ( info.sequence != 0U )
+            {
+                if ( !synced_ || (info.timestamp < previous_) || (info.timestamp - previous_ > UINT32_MAX) )
+                {
+                    if ( !writeClock(stream, info.timestamp) )
+                        return false;
+                }
+
+                header.sequence = info.sequence;
+                header.timestampDelta = static_cast<uint32_t>(info.timestamp - previous_);
+                previous_ = info.timestamp;
+            }
+
+            return BinaryWriter<Prefix_t, Header_t, Postfix_t>::write(stream, header, data);
+        }
+
+        template<typename ByteSink>
+        void close( ByteSink& stream )
+        {
+            synced_ = false; //< Next stream starts from a clock frame
+        }
+
+    private:
+        template<typename ByteSink>
+        bool writeClock(ByteSink& stream, const uint64_t timestamp)
+        {
+            Header_t header;
+            header.typeId = Header_t::cClockTypeId;
+            header.dataBytes = sizeof(timestamp);
+            header.sequence = 0U;
+            header.timestampDelta = 0U;
+
+            previous_ = timestamp;
+            synced_ = true;
+            return BinaryWriter<Prefix_t, Header_t, Postfix_t>::write(stream, header, timestamp);
+        }
+
+    private:
+        uint64_t previous_; ///< Timestamp the next delta is encoded from
+        bool synced_; ///< A clock frame has been written
+    };
+
+    /** Buffer register decoding MessageInfo from headers written by MessageInfoWriter
+     * @remark Registers a buffer for clock frames which set the timestamp that deltas are decoded from
+     */
+    template< typename Header_t, uint_fast16_t cMaxDataBufferCount = 64U >
+    class MessageInfoBufferRegister : public BufferRegister<Header_t, cMaxDataBufferCount>
+    {
+    public:
+        MessageInfoBufferRegister()
+            : BufferRegister<Header_t, cMaxDataBufferCount>()
+            , clockPublisher_()
+            , clock_(0U)
+            , previous_(0U)
+        {
+            Header_t header;
+            header.typeId = Header_t::cClockTypeId;
+            header.dataBytes = sizeof(clock_);
+            header.sequence = 0U;
+            header.timestampDelta = 0U;
+            this->set( header, Buffer{ &clockPublisher_, reinterpret_cast<char*>(&clock_), static_cast<uint_least16_t>(sizeof(clock_)), 0 } );
+        }
+
+        MessageInfoBufferRegister( const MessageInfoBufferRegister& ) = delete; ///< Registry refers to member buffers
+
+        bool close()
+        {
+            previous_ = 0U;
+            return BufferRegister<Header_t, cMaxDataBufferCount>::close();
+        }
+
+        /** Publish with MessageInfo decoded from header, or apply a clock frame
+         * @param header  Header data of the completed payload
+         * @param publisher  Publisher of the completed buffer
+         */
+        void publish(const Header_t& header, IPublish& publisher)
+        {
+            if ( &publisher == &clockPublisher_ )
+                previous_ = clock_;
+            else if ( header.sequence == 0U )
+                publisher.publish();
+            else
+            {
+                previous_ += header.timestampDelta;
+                publisher.publish( MessageInfo{ previous_, header.sequence } );
+            }
+        }
+
+    private:
+        /** Clock frames are consumed by the register
+        */
+        class ClockPublisher : public IPublish
+        {
+        public:
+            void publish() override {}
+        };
+
+        ClockPublisher clockPublisher_;
+        uint64_t clock_; ///< Buffer for clock frame payload
+        uint64_t previous_; ///< Timestamp the next delta is decoded from
+    };
+
+    /** Binary protocol carrying MessageInfo of each message
+     * @remark Extends DefaultSerialisation with per-topic sequence number and delta encoded timestamp in the Header.
+     *  Messages without MessageInfo are encoded with a zero sequence and published without metadata.
+     * @see HasMessageInfo
+     */
+    struct MessageInfoSerialisation
+    {
+        typedef DefaultSerialisation::Prefix Prefix;
+
+        /** Header containing signal type information and MessageInfo
+        */
+        struct Header : DefaultSerialisation::Header
+        {
+            static const uint32_t cClockTypeId = sub0::utility::FourCC<'C', 'L', 'C', 'K'>::value; ///< Reserved type identifier of clock frames
+
+            uint32_t sequence; ///< MessageInfo::sequence, 0 when the message carries no MessageInfo
+            uint32_t timestampDelta; ///< Nanoseconds since the previous timestamp in the stream
+
+            Header() = default;
+
+            /** header for specified Data type
+            */
+            template<typename Data>
+            Header( const Data& data )
+                : DefaultSerialisation::Header(data)
+                , sequence(0U)
+                , timestampDelta(0U)
+            {}
+        };
+
+        typedef DefaultSerialisation::Postfix Postfix;
+
+        using Writer = MessageInfoWriter<Prefix, Header, Postfix>;
+        using Reader = BinaryReader<Prefix, Header, Postfix, MessageInfoBufferRegister<Header> >;
+    };
+
+#if SUB0PUB_CAUSALITY
+    /** Writes binary frames with the SpanContext of each message encoded into the header
+     * @remark Header_t::traceId and spanId are those of the publish being delivered to the serialiser
+     */
+    template< typename Prefix_t
+            , typename Header_t
+            , typename Postfix_t >
+    class CausalityWriter : public BinaryWriter<Prefix_t, Header_t, Postfix_t>
+    {
+    public:
+        /** Output header with SpanContext of the message being delivered and pay-load for data as binary
+         * @param stream  Stream to write into
+         * @param data  Data to construct a header record and data payload for
+         */
+        template<typename Data_t, typename ByteSink>
+        inline bool write(ByteSink& stream, const Data_t& data) const
+        {
+            Header_t header(data);
+            const SpanContext& span = Causality::current();
+            header.traceId = span.traceId;
+            header.spanId = span.spanId;
+            return BinaryWriter<Prefix_t, Header_t, Postfix_t>::write(stream, header, data);
+        }
+    };
+
+    /** Buffer register publishing each frame as a child of the SpanContext decoded from its header
+     * @remark The trace continues across the stream, the remote span becomes the parent of the local publish
+     */
+    template< typename Header_t, uint_fast16_t cMaxDataBufferCount = 64U >
+    class CausalityBufferRegister : public BufferRegister<Header_t, cMaxDataBufferCount>
+    {
+    public:
+        /** Publish within a Causality::Scope of the decoded SpanContext
+         * @param header  Header data of the completed payload
+         * @param publisher  Publisher of the completed buffer
+         */
+        void publish(const Header_t& header, IPublish& publisher)
+        {
+            const Causality::Scope scope( SpanContext{ header.traceId, header.spanId, 0U } );
+            publisher.publish();
+        }
+    };
+
+    /** Binary protocol carrying the SpanContext of each message
+     * @remark Extends DefaultSerialisation with the traceId and spanId of the publish in the Header so causality
+     *  continues across process boundaries @see Causality
+     */
+    struct CausalitySerialisation
+    {
+        typedef DefaultSerialisation::Prefix Prefix;
+
+        /** Header containing signal type information and SpanContext
+        */
+        struct Header : DefaultSerialisation::Header
+        {
+            uint64_t traceId; ///< SpanContext::traceId of the publish, 0 when published outside a span
+            uint64_t spanId; ///< SpanContext::spanId of the publish
+
+            Header() = default;
+
+            /** header for specified Data type
+            */
+            template<typename Data>
+            Header( const Data& data )
+                : DefaultSerialisation::Header(data)
+                , traceId(0U)
+                , spanId(0U)
+            {}
+        };
+
+        typedef DefaultSerialisation::Postfix Postfix;
+
+        using Writer = CausalityWriter<Prefix, Header, Postfix>;
+        using Reader = BinaryReader<Prefix, Header, Postfix, CausalityBufferRegister<Header> >;
+    };
+#endif
+
     /** Serialises Sub0Pub data into a target stream object
      * @remark Serialised data can be received and published using the counterpart StreamDeserializer instance
      * @remark Can be used to create inter-process transfers very easily using the specified Protocol @see sub0::DefaultSerialisation
      * @tparam  Protocol  Stream data protocol to use defining how the data header and payload is structured
+     * @tparam  ByteSink  Stream type written to, OStream for type-erased streams or a concrete ByteSink e.g. MemorySink
+     *  allowing frame encoding to inline @see utility::write
      */
-    template< typename Protocol = DefaultSerialisation, typename ProtocolWriter = typename Protocol::Writer >
+    template< typename Protocol = DefaultSerialisation, typename ProtocolWriter = typename Protocol::Writer, typename ByteSink = OStream >
     class StreamSerializer
     {
     public:
 
         using WriterConfig = typename ProtocolWriter::Config;
 
-        using ForwardReceiver = StreamSerializer<Protocol,ProtocolWriter>; //<@note Allow disambiguation for forwarding from derived classes
+        using ForwardReceiver = StreamSerializer<Protocol,ProtocolWriter,ByteSink>; //<@note Allow disambiguation for forwarding from derived classes
 
     public:
         /** Construct from stream
          * @param[in] stream  Stream reference stored and used to write serialised data into
          */
-        StreamSerializer( OStream& stream )
+        StreamSerializer( ByteSink& stream )
             : ostream_(stream)
             , writer_()
         {}
@@ -1315,7 +3672,7 @@ namespace sub0
         }
 
     protected:
-        OStream& ostream_; ///< Stream into which data is serialised
+        ByteSink& ostream_; ///< Stream into which data is serialised
         ProtocolWriter writer_;
     };
 
@@ -1325,8 +3682,10 @@ namespace sub0
      *  could be a TcpStream or could be a file in simple cases. The serialised data is expected to be generated from a
      *  corresponding StreamSerializer instance for the same Protocol.
      * @tparam  Protocol  Stream data protocol to use defining how the data header and payload is structured
+     * @tparam  ByteSource  Stream type read from, IStream for type-erased streams or a concrete ByteSource e.g. MemorySource
+     *  @see utility::read
      */
-    template< typename Protocol = DefaultSerialisation, typename ProtocolReader = typename Protocol::Reader >
+    template< typename Protocol = DefaultSerialisation, typename ProtocolReader = typename Protocol::Reader, typename ByteSource = IStream >
     class StreamDeserializer
     {
     public:
@@ -1336,7 +3695,7 @@ namespace sub0
     public:
         /** Store reference to supplied IStream which will be read on update()
         */
-        StreamDeserializer( IStream& istream )
+        StreamDeserializer( ByteSource& istream )
             : istream_(istream)
             , reader_()
         {}
@@ -1378,7 +3737,7 @@ namespace sub0
         }
 
     protected:
-        IStream& istream_; ///< Stream from which data is de-serialized
+        ByteSource& istream_; ///< Stream from which data is de-serialized
         ProtocolReader reader_;
     };
 
@@ -1451,6 +3810,11 @@ namespace sub0
         virtual void publish() final
         { Publish<Data>::publish( buffer_ ); }
 
+        /** Publish the data populated in buffer_ with metadata decoded alongside it
+         */
+        virtual void publish( const MessageInfo& info ) final
+        { Publish<Data>::publish( buffer_, info ); }
+
     private:
         Data buffer_ = {}; ///< Data buffer to be published 
                       ///< @todo Double-buffer data storage for asynchronous processing and receive?
@@ -0,0 +1,148 @@
+/** Sub0Pub export of the live publisher/subscriber graph as JSON or Graphviz DOT
+ * @remark Opt-in extension of sub0pub.hpp
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#ifndef CROG_SUB0PUB_TOPOLOGY_HPP
+#define CROG_SUB0PUB_TOPOLOGY_HPP
+
+#include "sub0pub/sub0pub.hpp"
+
+#include <cstdio> //< std::snprintf
+
+namespace sub0
+{
+    /** Writes the brokers listed by Topology and the objects connected to them
+     * @remark Objects are identified by address, an object subscribing to one Data and publishing another appears as
+     *  a single node where RTTI is enabled. In DOT, topics are boxes whose outline widens with fan-out, and topics with
+     *  publishers but no subscribers are dashed.
+     */
+    class TopologyWriter
+    {
+    public:
+        /** Write each topic with its metrics, subscribers and publishers as a JSON document
+         * @param stream  ByteSink to write into @see utility::write
+         * @return False if writing to stream failed
+         */
+        template< typename ByteSink >
+        static bool writeJson( ByteSink& stream )
+        {
+            bool isGood = writeText( stream, "{\"topics\":[" );
+            bool isFirst = true;
+            Topology::visit( [&]( const BrokerInfo& info )
+            {
+                char name[128];
+                copyName( name, sizeof(name), info.typeName );
+
+                char line[512];
+                int count = std::snprintf( line, sizeof(line)
+                    , "%s\n{\"typeId\":%u,\"name\":\"%s\",\"dataBytes\":%u,\"subscriberCount\":%u,\"publisherCount\":%u"
+                      ",\"publishCount\":%u"
+                    , isFirst ? "" : ",", static_cast<unsigned>( info.typeId ), name, static_cast<unsigned>( info.dataBytes )
+                    , static_cast<unsigned>( info.subscriberCount ), static_cast<unsigned>( info.publisherCount )
+                    , static_cast<unsigned>( info.publishCount ) );
+#if SUB0PUB_PROFILE
+                if ( count > 0 && size_t(count) < sizeof(line) )
+                {
+                    count += std::snprintf( line + count, sizeof(line) - size_t(count)
+                        , ",\"receiveCount\":%llu,\"receiveNanoseconds\":%llu"
+                        , static_cast<unsigned long long>( info.receiveCount )
+                        , static_cast<unsigned long long>( info.receiveNanoseconds ) );
+                }
+#endif
+                isFirst = false;
+                isGood = isGood && (count > 0) && (size_t(count) < sizeof(line)) && utility::write( stream, line, size_t(count) )
+                    && writeObjects( stream, ",\"subscribers\":[", info.subscribers, info.subscriberCount )
+                    && writeObjects( stream, "],\"publishers\":[", info.publishers, info.listedPublisherCount )
+                    && writeText( stream, "]}" );
+            } );
+            return isGood && writeText( stream, "\n]}\n" );
+        }
+
+        /** Write the graph of publishers to topics to subscribers as a Graphviz DOT digraph
+         * @param stream  ByteSink to write into @see utility::write
+         * @return False if writing to stream failed
+         */
+        template< typename ByteSink >
+        static bool writeDot( ByteSink& stream )
+        {
+            bool isGood = writeText( stream, "digraph sub0pub {\n  rankdir=LR;\n  node [shape=ellipse];\n" );
+            uint32_t topic = 0U;
+            Topology::visit( [&]( const BrokerInfo& info )
+            {
+                char name[128];
+                copyName( name, sizeof(name), info.typeName );
+
+                const bool isDead = (info.subscriberCount == 0U) && (info.publisherCount != 0U);
+                char line[384];
+                const int count = std::snprintf( line, sizeof(line)
+                    , "  \"topic%u\" [shape=box,label=\"%s\\n%u bytes, %u sub, %u pub\",penwidth=%u%s];\n"
+                    , static_cast<unsigned>( topic ), name, static_cast<unsigned>( info.dataBytes )
+                    , static_cast<unsigned>( info.subscriberCount ), static_cast<unsigned>( info.publisherCount )
+                    , static_cast<unsigned>( info.subscriberCount > 1U ? info.subscriberCount : 1U )
+                    , isDead ? ",style=dashed" : "" );
+                isGood = isGood && (count > 0) && (size_t(count) < sizeof(line)) && utility::write( stream, line, size_t(count) );
+
+                char topicNode[16];
+                std::snprintf( topicNode, sizeof(topicNode), "topic%u", static_cast<unsigned>( topic ) );
+                for ( uint32_t iPublisher = 0U; isGood && iPublisher < info.listedPublisherCount; ++iPublisher )
+                {
+                    char objectNode[32];
+                    std::snprintf( objectNode, sizeof(objectNode), "%p", info.publishers[iPublisher] );
+                    isGood = writeEdge( stream, objectNode, topicNode );
+                }
+                for ( uint32_t iSubscriber = 0U; isGood && iSubscriber < info.subscriberCount; ++iSubscriber )
+                {
+                    char objectNode[32];
+                    std::snprintf( objectNode, sizeof(objectNode), "%p", info.subscribers[iSubscriber] );
+                    isGood = writeEdge( stream, topicNode, objectNode );
+                }
+                ++topic;
+            } );
+            return isGood && writeText( stream, "}\n" );
+        }
+
+    private:
+        template< typename ByteSink >
+        static bool writeText( ByteSink& stream, const char* const text )
+        { return utility::write( stream, text, std::strlen( text ) ); }
+
+        /** Write a JSON array body of object addresses
+         */
+        template< typename ByteSink >
+        static bool writeObjects( ByteSink& stream, const char* const prefix, const void* const* objects, const uint32_t count )
+        {
+            bool isGood = writeText( stream, prefix );
+            for ( uint32_t iObject = 0U; isGood && iObject < count; ++iObject )
+            {
+                char text[32];
+                const int length = std::snprintf( text, sizeof(text), "%s\"%p\"", (iObject != 0U) ? "," : "", objects[iObject] );
+                isGood = (length > 0) && (size_t(length) < sizeof(text)) && utility::write( stream, text, size_t(length) );
+            }
+            return isGood;
+        }
+
+        template< typename ByteSink >
+        static bool writeEdge( ByteSink& stream, const char* const from, const char* const to )
+        {
+            char text[96];
+            const int length = std::snprintf( text, sizeof(text), "  \"%s\" -> \"%s\";\n", from, to );
+            return (length > 0) && (size_t(length) < sizeof(text)) && utility::write( stream, text, size_t(length) );
+        }
+
+        /** Copy a type name keeping JSON and DOT strings valid without escaping
+         */
+        static void copyName( char* const name, const size_t size, const char* const typeName )
+        {
+            std::snprintf( name, size, "%s", (typeName != nullptr) ? typeName : "?" );
+            for ( char* iName = name; *iName != '\0'; ++iName )
+            {
+                if ( *iName == '"' || *iName == '\\' || static_cast<unsigned char>( *iName ) < 0x20U )
+                    *iName = '_';
+            }
+        }
+    };
+
+} // END: sub0
+
+#endif // CROG_SUB0PUB_TOPOLOGY_HPP
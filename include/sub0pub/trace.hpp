@@ -0,0 +1,110 @@
+/** Sub0Pub Chrome trace-event export of publish and receive spans
+ * @remark Opt-in extension of sub0pub.hpp, requires SUB0PUB_TRACE_EVENTS
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#ifndef CROG_SUB0PUB_TRACE_HPP
+#define CROG_SUB0PUB_TRACE_HPP
+
+#include "sub0pub/sub0pub.hpp"
+
+#include <cstdio> //< std::snprintf
+
+#if !SUB0PUB_TRACE_EVENTS
+#error "sub0pub/trace.hpp requires SUB0PUB_TRACE_EVENTS=true"
+#endif
+
+namespace sub0
+{
+    /** Writes events recorded by TraceSession as Chrome trace-event JSON
+     * @remark The output loads in chrome://tracing and Perfetto. Each publish and each receive is a duration span on
+     *  the track of its thread, and a flow arrow links each publish to the receive of each subscriber.
+     *  Spans cut by the TraceBuffer ring wrapping are dropped.
+     * @note Call once recording has stopped @see TraceSession::stop()
+     */
+    class ChromeTraceWriter
+    {
+    public:
+        /** Write all TraceBuffer as a JSON document
+         * @param stream  ByteSink to write into @see utility::write
+         * @return False if writing to stream failed
+         */
+        template< typename ByteSink >
+        static bool write( ByteSink& stream )
+        {
+            bool isGood = writeText( stream, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" );
+            bool isFirst = true;
+            TraceSession::visit( [&]( const TraceBuffer& buffer )
+            {
+                uint32_t depth = 0U; //< Open spans, ends without a retained begin are skipped
+                for ( size_t iEvent = 0U; isGood && iEvent < buffer.size(); ++iEvent )
+                {
+                    const TraceEvent& event = buffer[iEvent];
+                    const bool isBegin = (event.phase == TraceEvent::PublishBegin) || (event.phase == TraceEvent::ReceiveBegin);
+                    if ( !isBegin && depth == 0U )
+                        continue;
+                    depth = isBegin ? depth + 1U : depth - 1U;
+
+                    isGood = writeEvent( stream, buffer.threadIndex(), event, isFirst );
+                    isFirst = false;
+                }
+            } );
+            return isGood && writeText( stream, "\n]}\n" );
+        }
+
+    private:
+        template< typename ByteSink >
+        static bool writeText( ByteSink& stream, const char* const text )
+        { return utility::write( stream, text, std::strlen( text ) ); }
+
+        /** Write the span boundary and flow event of a TraceEvent
+         */
+        template< typename ByteSink >
+        static bool writeEvent( ByteSink& stream, const uint32_t threadIndex, const TraceEvent& event, const bool isFirst )
+        {
+            const bool isPublish = (event.phase == TraceEvent::PublishBegin) || (event.phase == TraceEvent::PublishEnd);
+            const bool isBegin = (event.phase == TraceEvent::PublishBegin) || (event.phase == TraceEvent::ReceiveBegin);
+
+            char name[64];
+            if ( event.typeName != nullptr )
+                std::snprintf( name, sizeof(name), "%s", event.typeName );
+            else if ( event.typeId != 0U )
+                std::snprintf( name, sizeof(name), "0x%x", static_cast<unsigned>( event.typeId ) );
+            else
+                std::snprintf( name, sizeof(name), "%s", isPublish ? "publish" : "receive" );
+            for ( char* iName = name; *iName != '\0'; ++iName ) //< Keep JSON string valid without escaping
+            {
+                if ( *iName == '"' || *iName == '\\' || static_cast<unsigned char>( *iName ) < 0x20U )
+                    *iName = '_';
+            }
+
+            const unsigned long long micros = static_cast<unsigned long long>( event.timestamp / 1000U );
+            const unsigned nanos = static_cast<unsigned>( event.timestamp % 1000U );
+            const unsigned long long flow = (static_cast<unsigned long long>( threadIndex ) << 32U) | event.flowId;
+
+            char line[384];
+            int count = std::snprintf( line, sizeof(line)
+                , "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%s\",\"ts\":%llu.%03u,\"pid\":1,\"tid\":%u"
+                  ",\"args\":{\"typeId\":%u,\"object\":\"%p\"}}"
+                , isFirst ? "" : ",", name, isPublish ? "publish" : "receive", isBegin ? "B" : "E", micros, nanos
+                , static_cast<unsigned>( threadIndex ), static_cast<unsigned>( event.typeId ), event.object );
+
+            // Flow starts at the publish, steps into each receive and ends with the publish
+            const char* const flowPhase = (event.phase == TraceEvent::PublishBegin) ? "s"
+                                        : (event.phase == TraceEvent::ReceiveBegin) ? "t"
+                                        : (event.phase == TraceEvent::PublishEnd) ? "f" : nullptr;
+            if ( flowPhase != nullptr && event.flowId != 0U && count > 0 && size_t(count) < sizeof(line) )
+            {
+                count += std::snprintf( line + count, sizeof(line) - size_t(count)
+                    , ",\n{\"name\":\"%s\",\"cat\":\"flow\",\"ph\":\"%s\",\"id\":\"0x%llx\",\"ts\":%llu.%03u,\"pid\":1,\"tid\":%u%s}"
+                    , name, flowPhase, flow, micros, nanos, static_cast<unsigned>( threadIndex )
+                    , (event.phase == TraceEvent::PublishEnd) ? ",\"bp\":\"e\"" : "" );
+            }
+
+            return (count > 0) && (size_t(count) < sizeof(line)) && utility::write( stream, line, size_t(count) );
+        }
+    };
+
+} // END: sub0
+
+#endif // CROG_SUB0PUB_TRACE_HPP
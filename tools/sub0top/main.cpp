@@ -0,0 +1,225 @@
+/** sub0top - live view of the topic counters of a process built with SUB0PUB_STATS
+ * @remark usage: sub0top [--interval=<seconds>] [--top=<count>] [--once] [<page>|<pid>]
+ *         The monitored process opens a StatsPage, topics are listed by publish rate over each interval.
+ *         Without a page the pages in /dev/shm are listed, and shown if there is only one.
+ *
+ *  This file is part of Sub0Pub, distributed under the MIT License (see LICENSE.md)
+ */
+#include "sub0pub/stats.hpp"
+
+#include <algorithm> //< std::sort
+#include <cerrno> //< errno
+#include <chrono> //< std::chrono::duration
+#include <cstdio> //< std::printf
+#include <cstdlib> //< std::atof
+#include <cstring> //< std::strncmp
+#include <string> //< std::string
+#include <thread> //< std::this_thread::sleep_for
+#include <vector> //< std::vector
+
+#include <dirent.h> //< opendir
+#include <signal.h> //< kill
+
+namespace
+{
+    /** Plain copy of the counters of one topic
+    */
+    struct Sample
+    {
+        std::string typeName;
+        uint32_t typeId;
+        uint32_t subscriberCount;
+        uint64_t publishCount;
+        uint64_t deliveryCount;
+        uint64_t dropCount;
+        uint64_t latencyBuckets[sub0::StatsTopic::cLatencyBucketCount];
+    };
+
+    /** Topic counters over one interval
+    */
+    struct Row
+    {
+        const Sample* sample;
+        double publishRate;
+        double deliveryRate;
+        double dropRate;
+        uint64_t p50; ///< Upper bound of the latency bucket in nanoseconds, 0 without publishes
+        uint64_t p99;
+    };
+
+    std::vector<Sample> read( const sub0::StatsLayout& layout )
+    {
+        const uint32_t count = std::min( layout.topicCount.load( std::memory_order_acquire ), sub0::StatsLayout::cMaxTopics + 0U );
+        std::vector<Sample> samples( count );
+        for ( uint32_t iTopic = 0U; iTopic < count; ++iTopic )
+        {
+            const sub0::StatsTopic& topic = layout.topics[iTopic];
+            Sample& sample = samples[iTopic];
+            sample.typeName.assign( topic.typeName, strnlen( topic.typeName, sizeof(topic.typeName) ) );
+            sample.typeId = topic.typeId;
+            sample.subscriberCount = topic.subscriberCount.load( std::memory_order_relaxed );
+            sample.publishCount = topic.publishCount.load( std::memory_order_relaxed );
+            sample.deliveryCount = topic.deliveryCount.load( std::memory_order_relaxed );
+            sample.dropCount = topic.dropCount.load( std::memory_order_relaxed );
+            for ( uint32_t iBucket = 0U; iBucket < sub0::StatsTopic::cLatencyBucketCount; ++iBucket )
+                sample.latencyBuckets[iBucket] = topic.latencyBuckets[iBucket].load( std::memory_order_relaxed );
+        }
+        return samples;
+    }
+
+    /** @return Upper bound in nanoseconds of the bucket holding 'fraction' of the publishes between samples
+    */
+    uint64_t percentile( const Sample& previous, const Sample& current, const double fraction )
+    {
+        uint64_t total = 0U;
+        for ( uint32_t iBucket = 0U; iBucket < sub0::StatsTopic::cLatencyBucketCount; ++iBucket )
+            total += current.latencyBuckets[iBucket] - previous.latencyBuckets[iBucket];
+
+        uint64_t cumulative = 0U;
+        for ( uint32_t iBucket = 0U; total != 0U && iBucket < sub0::StatsTopic::cLatencyBucketCount; ++iBucket )
+        {
+            cumulative += current.latencyBuckets[iBucket] - previous.latencyBuckets[iBucket];
+            if ( double(cumulative) >= fraction * double(total) )
+                return uint64_t(1U) << iBucket;
+        }
+        return 0U;
+    }
+
+    std::string formatNanoseconds( const uint64_t nanoseconds )
+    {
+        char text[32];
+        if ( nanoseconds == 0U )
+            std::snprintf( text, sizeof(text), "-" );
+        else if ( nanoseconds < 1000U )
+            std::snprintf( text, sizeof(text), "%lluns", static_cast<unsigned long long>( nanoseconds ) );
+        else if ( nanoseconds < 1000000U )
+            std::snprintf( text, sizeof(text), "%.1fus", double(nanoseconds) * 1e-3 );
+        else
+            std::snprintf( text, sizeof(text), "%.1fms", double(nanoseconds) * 1e-6 );
+        return text;
+    }
+
+    /** @return Names of the StatsPage objects in /dev/shm
+    */
+    std::vector<std::string> listPages()
+    {
+        std::vector<std::string> pages;
+        if ( DIR* const directory = opendir( "/dev/shm" ) )
+        {
+            while ( const dirent* const entry = readdir( directory ) )
+            {
+                if ( std::strncmp( entry->d_name, "sub0pub.", 8U ) == 0 )
+                    pages.push_back( std::string( "/" ) + entry->d_name );
+            }
+            closedir( directory );
+        }
+        std::sort( pages.begin(), pages.end() );
+        return pages;
+    }
+
+    void show( const char* const name, const sub0::StatsLayout& layout, const std::vector<Sample>& previous
+        , const std::vector<Sample>& current, const double seconds, const size_t top, const bool clearScreen )
+    {
+        std::vector<Row> rows;
+        for ( size_t iTopic = 0U; iTopic < current.size(); ++iTopic )
+        {
+            const Sample& now = current[iTopic];
+            const Sample before = (iTopic < previous.size()) ? previous[iTopic] : Sample{ now.typeName, now.typeId, 0U, 0U, 0U, 0U, {} };
+            rows.push_back( Row{ &now
+                , double(now.publishCount - before.publishCount) / seconds
+                , double(now.deliveryCount - before.deliveryCount) / seconds
+                , double(now.dropCount - before.dropCount) / seconds
+                , percentile( before, now, 0.5 ), percentile( before, now, 0.99 ) } );
+        }
+        std::sort( rows.begin(), rows.end(), []( const Row& lhs, const Row& rhs )
+        { return lhs.publishRate != rhs.publishRate ? lhs.publishRate > rhs.publishRate : lhs.sample->publishCount > rhs.sample->publishCount; } );
+
+        if ( clearScreen )
+            std::printf( "\x1b[H\x1b[2J" );
+        std::printf( "sub0top - %s pid %u - %zu topics - %.1f s interval\n\n", name, static_cast<unsigned>( layout.processId )
+            , current.size(), seconds );
+        std::printf( "%-32s %10s %5s %12s %12s %10s %8s %8s %14s\n"
+            , "TOPIC", "ID", "SUBS", "PUB/s", "DELIVER/s", "DROP/s", "p50", "p99", "PUBLISHES" );
+        for ( size_t iRow = 0U; iRow < rows.size() && iRow < top; ++iRow )
+        {
+            const Row& row = rows[iRow];
+            std::printf( "%-32.32s %10u %5u %12.0f %12.0f %10.0f %8s %8s %14llu\n"
+                , row.sample->typeName.c_str(), static_cast<unsigned>( row.sample->typeId )
+                , static_cast<unsigned>( row.sample->subscriberCount ), row.publishRate, row.deliveryRate, row.dropRate
+                , formatNanoseconds( row.p50 ).c_str(), formatNanoseconds( row.p99 ).c_str()
+                , static_cast<unsigned long long>( row.sample->publishCount ) );
+        }
+        std::fflush( stdout );
+    }
+
+} // END: anonymous
+
+int main( int argc, char* argv[] )
+{
+    double intervalSeconds = 1.0;
+    size_t top = 20U;
+    bool isOnce = false;
+    std::string name;
+
+    for ( int iArg = 1; iArg < argc; ++iArg )
+    {
+        const std::string arg = argv[iArg];
+        if ( arg.compare( 0, 11, "--interval=" ) == 0 )
+            intervalSeconds = std::max( std::atof( arg.c_str() + 11 ), 0.05 );
+        else if ( arg.compare( 0, 6, "--top=" ) == 0 )
+            top = static_cast<size_t>( std::atoi( arg.c_str() + 6 ) );
+        else if ( arg == "--once" )
+            isOnce = true;
+        else if ( arg.compare( 0, 2, "--" ) != 0 && name.empty() )
+            name = arg;
+        else
+        {
+            std::fprintf( stderr, "usage: %s [--interval=<seconds>] [--top=<count>] [--once] [<page>|<pid>]\n", argv[0] );
+            return 1;
+        }
+    }
+
+    if ( name.empty() )
+    {
+        const std::vector<std::string> pages = listPages();
+        if ( pages.size() != 1U )
+        {
+            std::printf( pages.empty() ? "No sub0pub stats pages found\n" : "Stats pages, select one:\n" );
+            for ( const std::string& page : pages )
+                std::printf( "  %s\n", page.c_str() );
+            return pages.empty() ? 1 : 0;
+        }
+        name = pages.front();
+    }
+    else if ( name.find_first_not_of( "0123456789" ) == std::string::npos )
+    {
+        char pageName[64];
+        sub0::StatsPage::defaultName( static_cast<uint32_t>( std::atol( name.c_str() ) ), pageName, sizeof(pageName) );
+        name = pageName;
+    }
+
+    sub0::StatsReader reader;
+    if ( !reader.open( name.c_str() ) )
+    {
+        std::fprintf( stderr, "Failed to open stats page '%s'\n", name.c_str() );
+        return 1;
+    }
+
+    const sub0::StatsLayout& layout = *reader.layout();
+    std::vector<Sample> previous = read( layout );
+    for ( ;; )
+    {
+        std::this_thread::sleep_for( std::chrono::duration<double>( intervalSeconds ) );
+        const std::vector<Sample> current = read( layout );
+        show( name.c_str(), layout, previous, current, intervalSeconds, top, !isOnce );
+        if ( isOnce )
+            return 0;
+
+        if ( layout.processId != 0U && kill( static_cast<pid_t>( layout.processId ), 0 ) != 0 && errno == ESRCH )
+        {
+            std::printf( "\nProcess %u exited\n", static_cast<unsigned>( layout.processId ) );
+            return 0;
+        }
+        previous = current;
+    }
+}